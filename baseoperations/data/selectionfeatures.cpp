@@ -32,28 +32,44 @@ SelectionFeatures::~SelectionFeatures()
 {
 }
 
-bool SelectionFeatures::createIndexes(const IFeatureCoverage& inputFC, ExecutionContext *ctx, SymbolTable &symTable){
-    std::set<quint32> resultset;
-
-    quint32 index = 0;
-    for(const auto& feature : inputFC){
-        QVariant val = feature(_attribColumn);
-        if ( QString(val.typeName()) == "QString" && QString(_rightSide.typeName()) == "QString"){
-            if ( compare1(_operator,val.toString(), _rightSide.toString()))
-                resultset.insert(index);
-        } else {
-            bool ok1,ok2;
-            double v1 = val.toDouble(&ok1);
-            double v2 = _rightSide.toDouble(&ok2);
-            bool ok3 = compare1(_operator, v1, v2);
-            if ( ok1&& ok2 && ok3)
-                resultset.insert(index);
+std::vector<QVariant> SelectionFeatures::attributeValues(const IFeatureCoverage &inputFC)
+{
+    if ( _attribColumn == "")
+        return std::vector<QVariant>();
+    return inputFC->attributeTable()->column(_attribColumn);
+}
 
+std::vector<bool> SelectionFeatures::selectionBitmap(const IFeatureCoverage &inputFC, const std::vector<QVariant> &values)
+{
+    // without a condition all features are selected
+    if ( _attribColumn == "" || _operator == loNONE)
+        return std::vector<bool>(_attribColumn == "" ? inputFC->featureCount() : values.size(), true);
+
+    std::vector<bool> selected(values.size(), false);
+    bool rightIsString = QString(_rightSide.typeName()) == "QString";
+    QString rightString = _rightSide.toString();
+    bool rightIsNumber;
+    double rightNumber = _rightSide.toDouble(&rightIsNumber);
+    for(quint32 index = 0; index < values.size(); ++index){
+        const QVariant& val = values[index];
+        if ( rightIsString && val.type() == QVariant::String){
+            selected[index] = compare1(_operator,val.toString(), rightString);
+        } else {
+            bool ok;
+            double v = val.toDouble(&ok);
+            selected[index] = ok && rightIsNumber && compare1(_operator, v, rightNumber);
         }
-        ++index;
-
     }
-    Indices result(resultset.begin(), resultset.end());
+    return selected;
+}
+
+bool SelectionFeatures::createIndexes(const IFeatureCoverage& inputFC, ExecutionContext *ctx, SymbolTable &symTable){
+    std::vector<bool> selected = selectionBitmap(inputFC, attributeValues(inputFC));
+
+    Indices result;
+    for(quint32 index = 0; index < selected.size(); ++index)
+        if ( selected[index])
+            result.push_back(index);
     if ( ctx != 0) {
         QVariant value;
         value.setValue<Indices>(result);
@@ -66,18 +82,25 @@ bool SelectionFeatures::createIndexes(const IFeatureCoverage& inputFC, Execution
 bool SelectionFeatures::createCoverage(const IFeatureCoverage& inputFC, ExecutionContext *ctx, SymbolTable &symTable)
 {
     IFeatureCoverage outputFC = _outputObj.as<FeatureCoverage>();
+    std::vector<QVariant> values = attributeValues(inputFC);
+    std::vector<bool> selected = selectionBitmap(inputFC, values);
 
     SubSetAsyncFunc selection = [&](const std::vector<quint32>& subset ) -> bool {
+        std::vector<SPFeatureI> features;
+        std::vector<QVariant> selectedValues;
         FeatureIterator iterIn(inputFC, subset);
-
-        for_each(iterIn, iterIn.end(), [&](SPFeatureI feature){
-            QVariant v = feature->cell(_attribColumn);
-            SPFeatureI newFeature = outputFC->newFeatureFrom(feature);
-            _attTable->record(NEW_RECORD,{newFeature->featureid(), v});
-
+        for(quint32 index : subset){
+            if ( index < selected.size() && selected[index]){
+                features.push_back(*iterIn);
+                if ( values.size() > 0)
+                    selectedValues.push_back(values[index]);
+            }
             ++iterIn;
         }
-        );
+        // the features and their records are added in one go
+        outputFC->newFeaturesFrom(features, inputFC->coordinateSystem());
+        if ( _attTable.isValid())
+            _attTable->column(_attribColumn, selectedValues);
         return true;
     };
     ctx->_threaded = false;
@@ -26,6 +26,8 @@ private:
     LogicalOperator _operator = loNONE;
     QVariant _rightSide;
 
+    std::vector<QVariant> attributeValues(const IFeatureCoverage& inputFC);
+    std::vector<bool> selectionBitmap(const IFeatureCoverage& inputFC, const std::vector<QVariant>& values);
     bool createCoverage(const IFeatureCoverage& inputFC, ExecutionContext *ctx, SymbolTable &symTable);
     bool createIndexes(const IFeatureCoverage &inputFC, ExecutionContext *ctx, SymbolTable &symTable);
 
@@ -40,13 +40,30 @@ bool ResampleRaster::execute(ExecutionContext *ctx, SymbolTable& symTable)
         RasterInterpolator interpolator(inputRaster, _method);
         PixelIterator iterEnd = iterOut.end();
         bool equalCsy = inputRaster->coordinateSystem()->isEqual(outputRaster->coordinateSystem().ptr());
+        GeoRefTransform outTransform = outputRaster->georeference()->transform();
+        std::vector<Coordinate> coords;
+        std::vector<double> values;
         while(iterOut != iterEnd) {
-            Pixel position = iterOut.position();
-            Coordinate coord = outputRaster->georeference()->pixel2Coord(Pixeld(position.x,(position.y)));
-            if ( !equalCsy)
-                coord = inputRaster->coordinateSystem()->coord2coord(outputRaster->coordinateSystem(),coord);
-            *iterOut = interpolator.coord2value(coord, iterOut.position().z);
-            ++iterOut;
+            // the values of a line are interpolated in one batch, after that they are written to the output
+            PixelIterator lineStart = iterOut;
+            Pixel lineposition = iterOut.position();
+            quint32 count = 0;
+            Pixel position = lineposition;
+            while(iterOut != iterEnd && position.y == lineposition.y && position.z == lineposition.z) {
+                ++count;
+                ++iterOut;
+                position = iterOut.position();
+            }
+            outTransform.lineCoordinates(lineposition.y, lineposition.x, count, coords);
+            if ( !equalCsy){
+                for(Coordinate& coord : coords)
+                    coord = inputRaster->coordinateSystem()->coord2coord(outputRaster->coordinateSystem(),coord);
+            }
+            interpolator.coord2value(coords, lineposition.z, values);
+            for(double v : values) {
+                *lineStart = v;
+                ++lineStart;
+            }
         }
         return true;
     };
@@ -55,27 +55,15 @@ bool SpatialRelationOperation::execute(ExecutionContext *ctx, SymbolTable &symTa
     IFeatureCoverage features = _coverage.as<FeatureCoverage>();
 
     std::set<quint32> resultset;
-    int index = 0;
     geos::geom::Geometry *geomRelation = _geometry.get();
-    try{
     if ( geomRelation != 0) {
-        for(auto iter : features){
-            int variantCount = iter->subFeatureCount();
-            for(int gindex = 0; gindex < variantCount; ++gindex){
-                for(int gi = 0; gi < geomRelation->getNumGeometries(); ++gi){
-                    const geos::geom::Geometry *geomCoverage = iter->geometry().get();
-                    if ( geomCoverage!= 0 &&_relation(geomCoverage,geomRelation->getGeometryN(gi) )){
-                        resultset.insert(index);
-                    }
-                }
-            }
-            ++index;
+        for(int gi = 0; gi < geomRelation->getNumGeometries(); ++gi){
+            std::vector<quint32> selected;
+            if (!features->select(geomRelation->getGeometryN(gi), _relation, selected))
+                return false;
+            resultset.insert(selected.begin(), selected.end());
         }
     }
-    } catch(geos::util::GEOSException& exc){
-        ERROR0(QString(exc.what()));
-        return false;
-    }
 
     std::vector<quint32> result(resultset.begin(), resultset.end());
     if ( ctx != 0) {
@@ -120,14 +108,10 @@ Ilwis::OperationImplementation *Contains::create(quint64 metaid, const Ilwis::Op
     return new Contains(metaid, expr);
 }
 
-bool Contains::contains(const geos::geom::Geometry *geomCoverage, const geos::geom::Geometry *geomRelation) {
-    return geomCoverage->contains(geomRelation);
-}
-
 OperationImplementation::State Contains::prepare(ExecutionContext *ctx, const SymbolTable &sym){
     if (!SpatialRelationOperation::prepare(ctx, sym) == sPREPARED)
         return sPREPAREFAILED;
-    _relation = Contains::contains;
+    _relation = FeatureCoverage::srCONTAINS;
     return sPREPARED;
 }
 
@@ -150,14 +134,10 @@ Ilwis::OperationImplementation *Covers::create(quint64 metaid, const Ilwis::Oper
     return new Covers(metaid, expr);
 }
 
-bool Covers::covers(const geos::geom::Geometry *geomCoverage, const geos::geom::Geometry *geomRelation) {
-    return  geomRelation->covers(geomCoverage);
-}
-
 OperationImplementation::State Covers::prepare(ExecutionContext *ctx, const SymbolTable &sym){
     if (!SpatialRelationOperation::prepare(ctx, sym) == sPREPARED)
         return sPREPAREFAILED;
-    _relation = Covers::covers;
+    _relation = FeatureCoverage::srCOVEREDBY;
     return sPREPARED;
 }
 
@@ -181,14 +161,10 @@ Ilwis::OperationImplementation *CoveredBy::create(quint64 metaid, const Ilwis::O
     return new CoveredBy(metaid, expr);
 }
 
-bool CoveredBy::coveredBy(const geos::geom::Geometry *geomCoverage, const geos::geom::Geometry *geomRelation) {
-    return geomRelation->coveredBy(geomCoverage);
-}
-
 OperationImplementation::State CoveredBy::prepare(ExecutionContext *ctx, const SymbolTable &sym){
     if (!SpatialRelationOperation::prepare(ctx, sym) == sPREPARED)
         return sPREPAREFAILED;
-    _relation = CoveredBy::coveredBy;
+    _relation = FeatureCoverage::srCOVERS;
     return sPREPARED;
 }
 
@@ -213,14 +189,10 @@ Ilwis::OperationImplementation *Touches::create(quint64 metaid, const Ilwis::Ope
     return new Touches(metaid, expr);
 }
 
-bool Touches::touches(const geos::geom::Geometry *geomCoverage, const geos::geom::Geometry *geomRelation) {
-    return geomRelation->touches(geomCoverage);
-}
-
 OperationImplementation::State Touches::prepare(ExecutionContext *ctx, const SymbolTable &sym){
     if (!SpatialRelationOperation::prepare(ctx, sym) == sPREPARED)
         return sPREPAREFAILED;
-    _relation = Touches::touches;
+    _relation = FeatureCoverage::srTOUCHES;
     return sPREPARED;
 }
 
@@ -244,14 +216,10 @@ Ilwis::OperationImplementation *Intersects::create(quint64 metaid, const Ilwis::
     return new Intersects(metaid, expr);
 }
 
-bool Intersects::intersects(const geos::geom::Geometry *geomCoverage, const geos::geom::Geometry *geomRelation) {
-    return geomRelation->intersects(geomCoverage);
-}
-
 OperationImplementation::State Intersects::prepare(ExecutionContext *ctx, const SymbolTable &sym){
     if (!SpatialRelationOperation::prepare(ctx, sym) == sPREPARED)
         return sPREPAREFAILED;
-    _relation = Intersects::intersects;
+    _relation = FeatureCoverage::srINTERSECTS;
     return sPREPARED;
 }
 
@@ -275,14 +243,10 @@ Ilwis::OperationImplementation *Disjoint::create(quint64 metaid, const Ilwis::Op
     return new Disjoint(metaid, expr);
 }
 
-bool Disjoint::disjoint(const geos::geom::Geometry *geomCoverage, const geos::geom::Geometry *geomRelation) {
-    return geomRelation->disjoint(geomCoverage);
-}
-
 OperationImplementation::State Disjoint::prepare(ExecutionContext *ctx, const SymbolTable &sym){
     if (!SpatialRelationOperation::prepare(ctx, sym) == sPREPARED)
         return sPREPAREFAILED;
-    _relation = Disjoint::disjoint;
+    _relation = FeatureCoverage::srDISJOINT;
     return sPREPARED;
 }
 
@@ -307,14 +271,10 @@ Ilwis::OperationImplementation *Within::create(quint64 metaid, const Ilwis::Oper
     return new Within(metaid, expr);
 }
 
-bool Within::within(const geos::geom::Geometry *geomCoverage, const geos::geom::Geometry *geomRelation) {
-    return geomRelation->within(geomCoverage);
-}
-
 OperationImplementation::State Within::prepare(ExecutionContext *ctx, const SymbolTable &sym){
     if (!SpatialRelationOperation::prepare(ctx, sym) == sPREPARED)
         return sPREPAREFAILED;
-    _relation = Within::within;
+    _relation = FeatureCoverage::srCONTAINS;
     return sPREPARED;
 }
 
@@ -339,14 +299,10 @@ Ilwis::OperationImplementation *Equals::create(quint64 metaid, const Ilwis::Oper
     return new Equals(metaid, expr);
 }
 
-bool Equals::equals(const geos::geom::Geometry *geomCoverage, const geos::geom::Geometry *geomRelation) {
-    return geomRelation->equals(geomCoverage);
-}
-
 OperationImplementation::State Equals::prepare(ExecutionContext *ctx, const SymbolTable &sym){
     if (!SpatialRelationOperation::prepare(ctx, sym) == sPREPARED)
         return sPREPAREFAILED;
-    _relation = Equals::equals;
+    _relation = FeatureCoverage::srEQUALS;
     return sPREPARED;
 }
 
@@ -370,14 +326,10 @@ Ilwis::OperationImplementation *Crosses::create(quint64 metaid, const Ilwis::Ope
     return new Crosses(metaid, expr);
 }
 
-bool Crosses::crosses(const geos::geom::Geometry *geomCoverage, const geos::geom::Geometry *geomRelation) {
-    return geomRelation->crosses(geomCoverage);
-}
-
 OperationImplementation::State Crosses::prepare(ExecutionContext *ctx, const SymbolTable &sym){
     if (!SpatialRelationOperation::prepare(ctx, sym) == sPREPARED)
         return sPREPAREFAILED;
-    _relation = Crosses::crosses;
+    _relation = FeatureCoverage::srCROSSES;
     return sPREPARED;
 }
 
@@ -401,14 +353,10 @@ Ilwis::OperationImplementation *Overlaps::create(quint64 metaid, const Ilwis::Op
     return new Overlaps(metaid, expr);
 }
 
-bool Overlaps::overlaps(const geos::geom::Geometry *geomCoverage, const geos::geom::Geometry *geomRelation) {
-    return geomRelation->overlaps(geomCoverage);
-}
-
 OperationImplementation::State Overlaps::prepare(ExecutionContext *ctx, const SymbolTable &sym){
     if (!SpatialRelationOperation::prepare(ctx, sym) == sPREPARED)
         return sPREPAREFAILED;
-    _relation = Overlaps::overlaps;
+    _relation = FeatureCoverage::srOVERLAPS;
     return sPREPARED;
 }
 
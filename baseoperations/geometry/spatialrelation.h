@@ -4,9 +4,6 @@
 namespace Ilwis {
 namespace BaseOperations {
 
-typedef std::function<bool(const geos::geom::Geometry *geom1, const geos::geom::Geometry *geom2)> SpatialRelation;
-
-
 class SpatialRelationOperation : public OperationImplementation
 {
 public:
@@ -22,7 +19,7 @@ protected:
     ICoverage _coverage;
     IFeatureCoverage _outputFeatures;
     std::unique_ptr<geos::geom::Geometry> _geometry;
-    SpatialRelation _relation;
+    FeatureCoverage::SpatialRelation _relation;
 };
 
 class Contains : public SpatialRelationOperation
@@ -39,9 +36,6 @@ public:
 
    NEW_OPERATION(Contains);
 
-protected:
-   static bool contains(const geos::geom::Geometry *geom1, const geos::geom::Geometry *geom2) ;
-
 };
 
 class Covers : public SpatialRelationOperation
@@ -58,9 +52,6 @@ public:
 
    NEW_OPERATION(Covers);
 
-protected:
-   static bool covers(const geos::geom::Geometry *geom1, const geos::geom::Geometry *geom2) ;
-
 };
 
 class CoveredBy : public SpatialRelationOperation
@@ -77,9 +68,6 @@ public:
 
    NEW_OPERATION(CoveredBy);
 
-protected:
-   static bool coveredBy(const geos::geom::Geometry *geom1, const geos::geom::Geometry *geom2) ;
-
 };
 
 class Touches : public SpatialRelationOperation
@@ -96,9 +84,6 @@ public:
 
    NEW_OPERATION(Touches);
 
-protected:
-   static bool touches(const geos::geom::Geometry *geom1, const geos::geom::Geometry *geom2) ;
-
 };
 
 class Intersects : public SpatialRelationOperation
@@ -115,9 +100,6 @@ public:
 
    NEW_OPERATION(Intersects);
 
-protected:
-   static bool intersects(const geos::geom::Geometry *geom1, const geos::geom::Geometry *geom2) ;
-
 };
 
 class Disjoint : public SpatialRelationOperation
@@ -134,9 +116,6 @@ public:
 
    NEW_OPERATION(Disjoint);
 
-protected:
-   static bool disjoint(const geos::geom::Geometry *geom1, const geos::geom::Geometry *geom2) ;
-
 };
 
 class Within : public SpatialRelationOperation
@@ -153,9 +132,6 @@ public:
 
    NEW_OPERATION(Within);
 
-protected:
-   static bool within(const geos::geom::Geometry *geom1, const geos::geom::Geometry *geom2) ;
-
 };
 
 class Equals : public SpatialRelationOperation
@@ -172,9 +148,6 @@ public:
 
    NEW_OPERATION(Equals);
 
-protected:
-   static bool equals(const geos::geom::Geometry *geom1, const geos::geom::Geometry *geom2) ;
-
 };
 
 class Crosses : public SpatialRelationOperation
@@ -191,9 +164,6 @@ public:
 
    NEW_OPERATION(Crosses);
 
-protected:
-   static bool crosses(const geos::geom::Geometry *geom1, const geos::geom::Geometry *geom2) ;
-
 };
 
 class Overlaps : public SpatialRelationOperation
@@ -210,9 +180,6 @@ public:
 
    NEW_OPERATION(Overlaps);
 
-protected:
-   static bool overlaps(const geos::geom::Geometry *geom1, const geos::geom::Geometry *geom2) ;
-
 };
 }
 }
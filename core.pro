@@ -52,6 +52,7 @@ SOURCES += core/kernel.cpp \
     core/ilwisobjects/table/flattable.cpp \
     core/ilwisobjects/table/columndefinition.cpp \
     core/ilwisobjects/coverage/featureiterator.cpp \
+    core/ilwisobjects/coverage/featurespatialindex.cpp \
     core/ilwisobjects/table/basetable.cpp \
     core/ilwisobjects/coverage/featurefactory.cpp \
     core/ilwisobjects/geometry/coordinatesystem/projectionimplementation.cpp \
@@ -63,6 +64,7 @@ SOURCES += core/kernel.cpp \
     core/ilwisobjects/operation/operationmetadata.cpp \
     core/ilwisobjects/operation/operationExpression.cpp \
     core/ilwisobjects/operation/commandhandler.cpp \
+    core/ilwisobjects/operation/operationprofiler.cpp \
     core/ilwisobjects/coverage/blockiterator.cpp \
     core/util/locker.cpp \
     core/ilwisobjects/domain/datadefinition.cpp \
@@ -72,6 +74,7 @@ SOURCES += core/kernel.cpp \
     core/util/mathhelper.cpp \
     core/ilwisobjects/domain/textdomain.cpp \
     core/ilwisobjects/geometry/georeference/georefadapter.cpp \
+    core/ilwisobjects/geometry/georeference/georeftransform.cpp \
     core/ilwisobjects/operation/symboltable.cpp \
     core/ilwisobjects/operation/operationhelpergrid.cpp \
     core/ilwisobjects/operation/operationhelper.cpp \
@@ -82,6 +85,7 @@ SOURCES += core/kernel.cpp \
     core/ilwisobjects/coverage/indexslicer.cpp \
     core/ilwisobjects/coverage/rastercoverage.cpp \
     core/ilwisobjects/coverage/rasterinterpolator.cpp \
+    core/ilwisobjects/coverage/rasteroverviews.cpp \
     core/ilwisobjects/operation/logicalexpressionparser.cpp \
     core/ilwisobjects/table/tableselector.cpp \
     core/ilwisobjects/table/tablemerger.cpp \
@@ -127,7 +131,8 @@ SOURCES += core/kernel.cpp \
     core/ilwisobjects/representation/representation.cpp \
     core/ilwisobjects/representation/colorlookup.cpp \
     core/ilwisobjects/representation/continuouscolorlookup.cpp \
-    core/ilwisobjects/representation/palettecolorlookup.cpp
+    core/ilwisobjects/representation/palettecolorlookup.cpp \
+    core/ilwisobjects/representation/colortable.cpp
 
 
 HEADERS += core/kernel.h\
@@ -183,6 +188,7 @@ HEADERS += core/kernel.h\
     core/ilwisobjects/table/flattable.h \
     core/ilwisobjects/table/columndefinition.h \
     core/ilwisobjects/coverage/featureiterator.h \
+    core/ilwisobjects/coverage/featurespatialindex.h \
     core/ilwisobjects/table/basetable.h \
     core/ilwisobjects/coverage/featurefactory.h \
     core/util/errmessages.h \
@@ -197,6 +203,7 @@ HEADERS += core/kernel.h\
     core/ilwisobjects/operation/operationExpression.h \
     core/ilwisobjects/operation/operationconnector.h \
     core/ilwisobjects/operation/commandhandler.h \
+    core/ilwisobjects/operation/operationprofiler.h \
     core/util/locker.h \
     core/ilwisobjects/coverage/raster.h \
     core/ilwisobjects/operation/ilwisoperation.h \
@@ -208,6 +215,7 @@ HEADERS += core/kernel.h\
     core/util/mathhelper.h \
     core/ilwisobjects/domain/textdomain.h \
     core/ilwisobjects/geometry/georeference/georefadapter.h \
+    core/ilwisobjects/geometry/georeference/georeftransform.h \
     core/ilwisobjects/operation/symboltable.h \
     core/ilwisobjects/operation/operationhelpergrid.h \
     core/ilwisobjects/operation/operationhelper.h \
@@ -218,6 +226,7 @@ HEADERS += core/kernel.h\
     core/ilwisobjects/coverage/indexslicer.h \
     core/ilwisobjects/coverage/rastercoverage.h \
     core/ilwisobjects/coverage/rasterinterpolator.h \
+    core/ilwisobjects/coverage/rasteroverviews.h \
     core/ilwisobjects/domain/itemiterator.h \
     core/ilwisobjects/operation/logicalexpressionparser.h \
     core/ilwisobjects/table/tableselector.h \
@@ -271,7 +280,8 @@ HEADERS += core/kernel.h\
     core/ilwisobjects/representation/representation.h \
     core/ilwisobjects/representation/colorlookup.h \
     core/ilwisobjects/representation/continuouscolorlookup.h \
-    core/ilwisobjects/representation/palettecolorlookup.h
+    core/ilwisobjects/representation/palettecolorlookup.h \
+    core/ilwisobjects/representation/colortable.h
 
 
 OTHER_FILES += \
@@ -20,6 +20,7 @@
 #include "catalog.h"
 #include "symboltable.h"
 #include "operationExpression.h"
+#include "commandhandler.h"
 
 
 
@@ -164,6 +165,8 @@ bool MasterCatalog::removeItems(const std::vector<Resource> &items){
         if ( iter != _knownHashes.end()) {
             _knownHashes.erase(iter);
         }
+        if ( resource.ilwisType() == itOPERATIONMETADATA)
+            commandhandler()->removeOperationMetadata(resource.id());
         QString stmt = QString("DELETE FROM mastercatalog WHERE itemid = %1" ).arg(resource.id());
         QSqlQuery db(kernel()->database());
         if(!db.exec(stmt)) {
@@ -185,6 +188,52 @@ bool MasterCatalog::addItems(const std::vector<Resource>& items)
     if( items.size() == 0) // nothing to do; not wrong perse
             return true;
 
+    std::vector<Resource> newItems;
+    newItems.reserve(items.size());
+    for(const Resource &resource : items) {
+        if (!resource.isValid())
+           continue;
+        if ( mastercatalog()->contains(resource.url(), resource.ilwisType()))
+          continue;
+        if ( _batchDepth > 0) {
+            // pending items are not yet in the database so contains() can not see them
+            QString key = QString("%1|%2").arg(resource.url().toString()).arg(resource.ilwisType());
+            if ( !_pendingUrls.insert(key).second)
+                continue;
+        }
+        newItems.push_back(resource);
+    }
+    if ( _batchDepth > 0) {
+        std::copy(newItems.begin(), newItems.end(), std::back_inserter(_pendingItems));
+        return true;
+    }
+
+    return storeItems(newItems);
+
+}
+
+void MasterCatalog::beginBatch()
+{
+    ++_batchDepth;
+}
+
+bool MasterCatalog::endBatch()
+{
+    if ( _batchDepth == 0 || --_batchDepth > 0)
+        return true;
+
+    std::vector<Resource> items;
+    items.swap(_pendingItems);
+    _pendingUrls.clear();
+
+    return storeItems(items);
+}
+
+bool MasterCatalog::storeItems(const std::vector<Resource>& items)
+{
+    if( items.size() == 0)
+            return true;
+
     QSqlQuery queryItem(kernel()->database()), queryProperties(kernel()->database());
 
     bool ok = queryItem.prepare("INSERT INTO mastercatalog VALUES(\
@@ -204,15 +253,15 @@ bool MasterCatalog::addItems(const std::vector<Resource>& items)
         return false;
     }
 
+    bool transaction = items.size() > 1 && kernel()->database().transaction();
     for(const Resource &resource : items) {
-        if (!resource.isValid())
-           continue;
-        if ( mastercatalog()->contains(resource.url(), resource.ilwisType()))
-          continue;
-
         _knownHashes.insert(Ilwis::qHash(resource));
         resource.store(queryItem, queryProperties);
+        if ( resource.ilwisType() == itOPERATIONMETADATA)
+            commandhandler()->addOperationMetadata(resource);
     }
+    if ( transaction)
+        kernel()->database().commit();
 
 
     return true;
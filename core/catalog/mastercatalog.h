@@ -53,6 +53,18 @@ public:
      */
     bool addItems(const std::vector<Ilwis::Resource> &items);
 
+    /**
+     * Starts collecting the items passed to addItems instead of storing them one call at a time.
+     * Batches may be nested; the outermost endBatch stores everything collected in one transaction.
+     * Used while loading plugins, where every operation registers its own metadata.
+     */
+    void beginBatch();
+    /**
+     * Ends a batch started with beginBatch and stores the collected items
+     * @return true when succesful
+     */
+    bool endBatch();
+
 
     /**
      * Removes a list of Resources from the MasterCatalog
@@ -188,12 +200,17 @@ public:
 #endif
 
 private:
+    bool storeItems(const std::vector<Ilwis::Resource> &items);
+
     static MasterCatalog *_masterCatalog;
     quint64 _baseid;
     QHash<quint64, ESPIlwisObject> _lookup;
     std::set<QUrl> _catalogs;
     std::set<uint> _knownHashes;
     std::set<QString> _containerExceptions; // for some schemes the mastercatelog shouldnt try to find containers as they dont make sense;
+    quint32 _batchDepth = 0;
+    std::vector<Resource> _pendingItems;
+    std::set<QString> _pendingUrls;
 };
 
 //typedef QHash<IlwisResource, QList<CatalogCreate>  > CatalogCollection;
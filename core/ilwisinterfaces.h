@@ -17,6 +17,10 @@ class ColumnDefinition;
 
 typedef IlwisData<FeatureCoverage> IFeatureCoverage;
 typedef std::unique_ptr<geos::geom::Geometry> UPGeometry;
+/*!
+ * a geometry that may be shared by features (e.g. of a coverage and of the coverages derived from it); it is never modified in place.
+ */
+typedef std::shared_ptr<const geos::geom::Geometry> SPGeometry;
 typedef std::unique_ptr<geos::geom::GeometryFactory> UPGeomFactory;
 
 class KERNELSHARED_EXPORT FeatureVariantInterface {
@@ -53,8 +57,10 @@ public:
 
     virtual IlwisTypes geometryType() const  = 0;
     virtual void geometry(geos::geom::Geometry *geom)  = 0;
-    virtual const UPGeometry& geometry() const = 0;
-    //virtual UPGeometry& geometryRef() = 0;
+    virtual void geometry(const SPGeometry& geom)  = 0;
+    virtual const SPGeometry& geometry() const = 0;
+    virtual geos::geom::Geometry *geometryRef() = 0;
+    virtual quint32 geometryVersion() const = 0;
 
     virtual Record& recordRef() = 0;
     virtual const Record& record() const = 0;
@@ -198,6 +198,7 @@ BlockIterator::BlockIterator(IRasterCoverage raster, const Size<> &sz, const Bou
     _stepsizes(stepsize.isValid() ? stepsize : sz)
 
 {
+    flagBlocks();
 }
 
 BlockIterator::BlockIterator(quint64 endpos) : PixelIterator(endpos), _block(*this)
@@ -222,6 +223,7 @@ BlockIterator& BlockIterator::operator ++()
         dist = _box.xlength() * _box.ylength() * (_stepsizes.zsize() - 1);
         move(dist);
     }
+    flagBlocks();
 
     return *this;
 
@@ -230,9 +232,28 @@ BlockIterator& BlockIterator::operator ++()
 BlockIterator &BlockIterator::operator --()
 {
     move(-_blocksize.xsize());
+    flagBlocks();
     return *this;
 }
 
+void BlockIterator::flagBlocks()
+{
+    // the cells of a block may lie in several blocks of the grid; they are flagged once when the block enters them
+    if ( _grid == 0 || isAtEnd())
+        return;
+    qint32 first = _y / _grid->maxLines();
+    qint32 last = std::min(_y + (qint32)_blocksize.ysize() - 1, _endy) / _grid->maxLines();
+    qint32 zlast = std::min(_z + (qint32)_blocksize.zsize() - 1, _endz);
+    if ( first == _flaggedFirst && last == _flaggedLast && _z == _flaggedZ)
+        return;
+    for(qint32 z = _z; z <= zlast; ++z)
+        for(qint32 block = first; block <= last; ++block)
+            _grid->changed(z * _grid->blocksPerBand() + block, true);
+    _flaggedFirst = first;
+    _flaggedLast = last;
+    _flaggedZ = _z;
+}
+
 BlockIterator BlockIterator::end() const
 {
     return BlockIterator(_endposition);
@@ -98,10 +98,15 @@ public:
     void stepsizes(const Size<>& stepsize);
 private:
     BlockIterator(quint64 endpos);
+    void flagBlocks();
+
     GridBlock _block;
     Size<> _blocksize;
     Size<> _stepsizes;
     double _outside=rILLEGAL;
+    qint32 _flaggedFirst = -1;
+    qint32 _flaggedLast = -1;
+    qint32 _flaggedZ = -1;
 };
 
 
@@ -77,18 +77,20 @@ const SPFeatureI SPFeatureI::operator[]( quint32 subFeatureIndex) const
 //    return *this;
 //}
 
-VertexIterator SPFeatureI::begin()
+VertexIterator SPFeatureI::begin() const
 {
     if (!get())
         return VertexIterator();
-    return ::begin((*this)->geometry());
+    return VertexIterator((*this)->geometry().get());
 }
 
-VertexIterator SPFeatureI::end()
+VertexIterator SPFeatureI::end() const
 {
     if (!get())
         return VertexIterator();
-    return ::end((*this)->geometry());
+    VertexIterator iter((*this)->geometry().get());
+    iter += ENDVERTEX;
+    return iter;
 }
 
 //--------------------------------------------
@@ -337,7 +339,9 @@ void Feature::loadGeometry(QDataStream &stream)
         }
         _geometry.reset(factory->createMultiPolygon(subgeoms));
     }
+    ++_geometryVersion;
     _parentFCoverage->setFeatureCount( GeometryHelper::geometryType(_geometry.get()),1,FeatureInfo::ALLFEATURES);
+    _parentFCoverage->invalidateSpatialIndex();
 
 }
 
@@ -368,20 +372,40 @@ bool Feature::isValid() const {
     return _attributes.isValid() || _geometry;
 }
 
-//UPGeometry &Feature::geometryRef(){
-//    return _geometry;
-//}
+geos::geom::Geometry *Feature::geometryRef(){
+    if ( !_geometry)
+        return 0;
+    // see the header; the use count is only meaningful when nobody copies the geometry concurrently
+    if ( _geometry.use_count() > 1)
+        _geometry.reset(_geometry->clone());
+    // the caller may change the geometry
+    ++_geometryVersion;
+    _parentFCoverage->invalidateSpatialIndex();
+    return const_cast<geos::geom::Geometry *>(_geometry.get());
+}
 
-const UPGeometry &Feature::geometry() const{
+const SPGeometry &Feature::geometry() const{
     return _geometry;
 }
 
 void Feature::geometry(geos::geom::Geometry *geom){
+    geometry(SPGeometry(geom));
+}
+
+void Feature::geometry(const SPGeometry &geom)
+{
     IlwisTypes geomType = geometryType();
     _parentFCoverage->setFeatureCount(geomType,-1, _level);
-    _geometry.reset(geom);
+    _geometry = geom;
+    ++_geometryVersion;
     geomType = geometryType();
     _parentFCoverage->setFeatureCount(geomType,1, _level);
+    _parentFCoverage->invalidateSpatialIndex();
+}
+
+quint32 Feature::geometryVersion() const
+{
+    return _geometryVersion;
 }
 
 void Feature::removeSubFeature(const QString &subFeatureIndex)
@@ -431,8 +455,7 @@ FeatureInterface *Feature::clone(FeatureCoverage *fcoverage) const
         f->_subFeatures[node.first].reset(node.second->clone(fcoverage));
     }
     f->_parentFCoverage.set(fcoverage);
-    if ( _geometry)
-        f->_geometry.reset(_geometry->clone());
+    f->_geometry = _geometry; // shared, geometries are copied when they are modified
     f->_attributes = _attributes;
     f->_level = _level;
 
@@ -35,8 +35,12 @@ public:
     SPFeatureI operator[](quint32 subFeatureIndex);
     const SPFeatureI operator[](quint32 subFeatureIndex) const;
     //SPFeatureI& operator = (const SPFeatureI& otherFeature);
-    VertexIterator begin();
-    VertexIterator end();
+    /*!
+     * \brief begin iterates over the vertices of the geometry for reading. Reading has no side effects, a shared geometry stays shared.
+     * To change vertices iterate over geometryRef() instead, e.g. VertexIterator iter(feature->geometryRef()), and compare with end(iter)
+     */
+    VertexIterator begin() const;
+    VertexIterator end() const;
 };
 
 
@@ -80,9 +84,24 @@ public:
     quint32 attributeColumnCount() const;
 
     IlwisTypes geometryType() const;
-    const UPGeometry& geometry() const;
-    //UPGeometry& geometryRef();
+    const SPGeometry& geometry() const;
+    /*!
+     * \brief geometryRef the geometry for modification; a geometry that is shared with other features is copied first (copy on write)
+     *
+     * Whether the geometry is shared is decided on its use count, which is only reliable if no other thread copies the geometry at the
+     * same time. Changing geometries therefore requires exclusive access to the coverage, and to the coverages its features were copied
+     * from or to (e.g. no drawer preparing them and no newFeaturesFrom running on them). Reading through geometry() has no such restriction.
+     */
+    geos::geom::Geometry *geometryRef();
     void geometry(geos::geom::Geometry *geom);
+    /*!
+     * \brief geometry shares an existing geometry with this feature
+     */
+    void geometry(const SPGeometry& geom);
+    /*!
+     * \brief geometryVersion changes every time the geometry of the feature is replaced, derived data of the geometry (e.g. triangulations for drawing) can use it to check if they are still valid
+     */
+    quint32 geometryVersion() const;
 
     SPFeatureI subFeatureRef(double subFeatureIndex);
     SPFeatureI subFeatureRef(const QString &subFeatureIndex);
@@ -104,7 +123,8 @@ private:
     quint64 _featureid; // unique
     SubFeatures _subFeatures;
     Record _attributes;
-    UPGeometry _geometry;
+    SPGeometry _geometry;
+    quint32 _geometryVersion = 0;
     IFeatureCoverage _parentFCoverage;
     qint32 _level = 0;
 
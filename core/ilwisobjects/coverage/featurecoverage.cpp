@@ -10,6 +10,7 @@
 #include "attributetable.h"
 #include "feature.h"
 #include "featureiterator.h"
+#include "featurespatialindex.h"
 #include "geos/geom/CoordinateFilter.h"
 #include "geos/geom/PrecisionModel.h"
 #ifdef Q_OS_WIN
@@ -17,6 +18,9 @@
 #endif
 #include "geos/geom/GeometryFactory.h"
 #include "geos/io/ParseException.h"
+#include "geos/geom/prep/PreparedGeometry.h"
+#include "geos/geom/prep/PreparedGeometryFactory.h"
+#include "geos/util/GEOSException.h"
 #include "geometryhelper.h"
 #include "csytransform.h"
 
@@ -60,6 +64,125 @@ std::vector<quint32> FeatureCoverage::select(const QString &spatialQuery) const
     return std::vector<quint32>();
 }
 
+std::vector<quint32> FeatureCoverage::select(const Envelope &envelope)
+{
+    if ( !envelope.isValid())
+        return std::vector<quint32>();
+    geos::geom::Envelope env(envelope.min_corner().x, envelope.max_corner().x, envelope.min_corner().y, envelope.max_corner().y);
+    return spatialIndex()->candidates(env);
+}
+
+namespace {
+bool relationHolds(const geos::geom::Geometry *feature, const geos::geom::prep::PreparedGeometry *query, FeatureCoverage::SpatialRelation relation){
+    // the query geometry is the prepared one, so the relations are expressed from its side
+    switch(relation){
+    case FeatureCoverage::srCONTAINS:
+        return query->within(feature);
+    case FeatureCoverage::srCOVERS:
+        return query->coveredBy(feature);
+    case FeatureCoverage::srCOVEREDBY:
+        return query->covers(feature);
+    case FeatureCoverage::srTOUCHES:
+        return query->touches(feature);
+    case FeatureCoverage::srINTERSECTS:
+        return query->intersects(feature);
+    case FeatureCoverage::srDISJOINT:
+        return query->disjoint(feature);
+    case FeatureCoverage::srWITHIN:
+        return query->contains(feature);
+    case FeatureCoverage::srEQUALS:
+        return query->getGeometry().equals(feature);
+    case FeatureCoverage::srCROSSES:
+        return query->crosses(feature);
+    case FeatureCoverage::srOVERLAPS:
+        return query->overlaps(feature);
+    }
+    return false;
+}
+}
+
+bool FeatureCoverage::select(const geos::geom::Geometry *geometry, SpatialRelation relation, std::vector<quint32>& result, const FeaturePredicate& predicate)
+{
+    result.clear();
+    if ( geometry == 0)
+        return ERROR2(ERR_NO_INITIALIZED_2, TR("Geometry"), TR("spatial selection"));
+
+    try {
+        SPFeatureSpatialIndex index = spatialIndex();
+        std::unique_ptr<const geos::geom::prep::PreparedGeometry, void(*)(const geos::geom::prep::PreparedGeometry *)>
+                prepared(geos::geom::prep::PreparedGeometryFactory::prepare(geometry), geos::geom::prep::PreparedGeometryFactory::destroy);
+        auto accept = [&](quint32 findex, bool testRelation) -> bool {
+            const SPFeatureI& feature = index->feature(findex);
+            const geos::geom::Geometry *geom = feature ? feature->geometry().get() : 0;
+            if ( geom == 0)
+                return false;
+            if ( testRelation && !relationHolds(geom, prepared.get(), relation))
+                return false;
+            return !predicate || predicate(feature);
+        };
+        // all relations except disjoint need the envelopes to intersect; so the index delivers all possible candidates
+        std::vector<quint32> candidates = index->candidates(*geometry->getEnvelopeInternal());
+        if ( relation == srDISJOINT) {
+            quint32 candidate = 0;
+            for(quint32 findex = 0; findex < index->featureCount(); ++findex){
+                while ( candidate < candidates.size() && candidates[candidate] < findex)
+                    ++candidate;
+                bool isCandidate = candidate < candidates.size() && candidates[candidate] == findex;
+                if ( accept(findex, isCandidate))
+                    result.push_back(findex);
+            }
+        } else {
+            for(quint32 findex : candidates){
+                if ( accept(findex, true))
+                    result.push_back(findex);
+            }
+        }
+    } catch(geos::util::GEOSException& exc){
+        result.clear();
+        return ERROR0(QString(exc.what()));
+    }
+
+    return true;
+}
+
+std::vector<quint32> FeatureCoverage::selectAttributes(const FeaturePredicate &predicate)
+{
+    std::vector<quint32> result;
+    if ( !predicate)
+        return result;
+    {
+        Locker<std::mutex> lock(_loadmutex);
+        if (!connector().isNull() && !connector()->dataIsLoaded()) {
+            connector()->loadData(this);
+        }
+    }
+    for(quint32 findex = 0; findex < _features.size(); ++findex){
+        if ( _features[findex] && predicate(_features[findex]))
+            result.push_back(findex);
+    }
+    return result;
+}
+
+SPFeatureSpatialIndex FeatureCoverage::spatialIndex()
+{
+    {
+        Locker<std::mutex> lock(_loadmutex);
+        if (!connector().isNull() && !connector()->dataIsLoaded()) {
+            connector()->loadData(this);
+        }
+    }
+    Locker<std::mutex> lock(_indexmutex);
+    if ( !_spatialIndex)
+        _spatialIndex.reset(new FeatureSpatialIndex(_features));
+    return _spatialIndex;
+}
+
+void FeatureCoverage::invalidateSpatialIndex()
+{
+    Locker<std::mutex> lock(_indexmutex);
+    _spatialIndex.reset();
+}
+
 IlwisTypes FeatureCoverage::featureTypes() const
 {
     return _featureTypes;
@@ -92,12 +215,15 @@ SPFeatureI FeatureCoverage::newFeature(geos::geom::Geometry *geom, bool load) {
     auto *newfeature =  createNewFeature(tp);
     if (newfeature ){
         if ( geom) {
-            CoordinateSystem *csy = GeometryHelper::getCoordinateSystem(geom);
-            if ( csy && !csy->isEqual(coordinateSystem().ptr())){
-                CsyTransform trans(csy, coordinateSystem());
-                geom->apply_rw(&trans);
+            quint64 csyId = GeometryHelper::getCoordinateSystemId(geom);
+            if ( csyId != i64UNDEF && csyId != coordinateSystem()->id()) {
+                ICoordinateSystem csy = GeometryHelper::getCoordinateSystem(geom);
+                if ( csy.isValid() && !csy->isEqual(coordinateSystem().ptr())){
+                    CsyTransform trans(csy, coordinateSystem());
+                    geom->apply_rw(&trans);
+                }
             }
-            GeometryHelper::setCoordinateSystem(geom, coordinateSystem().ptr());
+            GeometryHelper::setCoordinateSystem(geom, coordinateSystem());
             newfeature->geometry(geom);
         }else
             setFeatureCount(itUNKNOWN,1,0);
@@ -112,33 +238,69 @@ SPFeatureI FeatureCoverage::newFeature(geos::geom::Geometry *geom, bool load) {
 SPFeatureI FeatureCoverage::newFeatureFrom(const SPFeatureI& existingFeature, const ICoordinateSystem& csySource) {
     Locker<> lock(_mutex);
 
-    auto transform = [&](const UPGeometry& geom)->geos::geom::Geometry * {
+    if (!connector()->dataIsLoaded()) {
+        connector()->loadData(this);
+    }
+    bool transform = csySource.isValid() && !csySource->isEqual(coordinateSystem().ptr());
+    return copyFeature(existingFeature, csySource, transform);
+}
+
+std::vector<SPFeatureI> FeatureCoverage::newFeaturesFrom(const std::vector<SPFeatureI> &existingFeatures, const ICoordinateSystem &csySource)
+{
+    Locker<> lock(_mutex);
+
+    if (!connector()->dataIsLoaded()) {
+        connector()->loadData(this);
+    }
+    bool transform = csySource.isValid() && !csySource->isEqual(coordinateSystem().ptr());
+    std::vector<SPFeatureI> newFeatures;
+    newFeatures.reserve(existingFeatures.size());
+    _features.reserve(_features.size() + existingFeatures.size());
+    for(const SPFeatureI& existingFeature : existingFeatures)
+        newFeatures.push_back(copyFeature(existingFeature, csySource, transform));
+
+    return newFeatures;
+}
+
+SPFeatureI FeatureCoverage::copyFeature(const SPFeatureI &existingFeature, const ICoordinateSystem &csySource, bool transform)
+{
+    // a geometry that already is in the coordinate system of this coverage is shared (it is immutable); others are copied and tagged
+    // with the coordinate system of this coverage, transformed if needed
+    auto copyGeometry = [&](const SPGeometry& geom)->SPGeometry {
         if ( geom.get() == 0)
-            return 0;
+            return geom;
+        if ( !transform) {
+            geos::geom::Geometry *shared = const_cast<geos::geom::Geometry *>(geom.get());
+            quint64 csyId = GeometryHelper::getCoordinateSystemId(shared);
+            if ( csyId == coordinateSystem()->id())
+                return geom;
+            if ( csyId != i64UNDEF) {
+                ICoordinateSystem csyGeom = GeometryHelper::getCoordinateSystem(shared);
+                if ( csyGeom.isValid() && csyGeom->isEqual(coordinateSystem().ptr()))
+                    return geom;
+            }
+        }
 
         geos::geom::Geometry *newgeom = geom->clone();
-        if ( csySource.isValid() && !csySource->isEqual(coordinateSystem().ptr())){
+        if ( transform) {
             CsyTransform trans(csySource, coordinateSystem());
             newgeom->apply_rw(&trans);
             newgeom->geometryChangedAction();
         }
-        GeometryHelper::setCoordinateSystem(newgeom, coordinateSystem().ptr());
+        GeometryHelper::setCoordinateSystem(newgeom, coordinateSystem());
 
-        return newgeom;
+        return SPGeometry(newgeom);
     };
-    if (!connector()->dataIsLoaded()) {
-        connector()->loadData(this);
-    }
     auto *newfeature = createNewFeature(existingFeature->geometryType());
-    const UPGeometry& geom = existingFeature->geometry();
-    newfeature->geometry(transform(geom)) ;
+    const SPGeometry& geom = existingFeature->geometry();
+    newfeature->geometry(copyGeometry(geom)) ;
 
     auto variantIndexes = _attributeDefinition.indexes();
     for(auto index : variantIndexes){
         const auto& variant = existingFeature[index];
         auto *variantFeature = createNewFeature(variant->geometryType());
         const auto& geom = variant->geometry();
-        variantFeature->geometry(transform(geom)) ;
+        variantFeature->geometry(copyGeometry(geom)) ;
         newfeature->setSubFeature(index, variantFeature);
 
 
@@ -155,6 +317,7 @@ FeatureInterface *FeatureCoverage::createNewFeature(IlwisTypes tp) {
         throw FeatureCreationError(TR("Readonly feature coverage, no creation allowed"));
     }
     changed(true);
+    invalidateSpatialIndex();
 
     _featureTypes |= tp;
     if ( _featureFactory == 0) {
@@ -2,6 +2,7 @@
 #define FEATURECOVERAGE_H
 
 #include <memory>
+#include <functional>
 #include "kernel_global.h"
 #include "ilwisinterfaces.h"
 
@@ -22,6 +23,9 @@ typedef std::vector<SPFeatureI> Features;
 
 class FeatureIterator;
 class FeatureFactory;
+class FeatureSpatialIndex;
+typedef std::shared_ptr<FeatureSpatialIndex> SPFeatureSpatialIndex;
+typedef std::function<bool(const SPFeatureI& feature)> FeaturePredicate;
 typedef std::unique_ptr<geos::geom::GeometryFactory> UPGeomFactory;
 
 struct FeatureInfo {
@@ -79,6 +83,11 @@ struct FeatureInfo {
 class KERNELSHARED_EXPORT FeatureCoverage : public Coverage, public FeatureCoverageInterface
 {
 public:
+    /**
+     * Spatial relations for selection. The relation is read as "feature relation geometry", e.g. srWITHIN selects the
+     * features that are within the query geometry
+     */
+    enum SpatialRelation{srCONTAINS, srCOVERS, srCOVEREDBY, srTOUCHES, srINTERSECTS, srDISJOINT, srWITHIN, srEQUALS, srCROSSES, srOVERLAPS};
 
     friend class FeatureIterator;
     friend class AttributeTable;
@@ -137,6 +146,15 @@ public:
      * @return A new feature or a nullptr if the given Feature was invalid
      */
     SPFeatureI newFeatureFrom(const Ilwis::SPFeatureI &existingFeature, const Ilwis::ICoordinateSystem &csySource=ICoordinateSystem());
+    /**
+     * Creates new Features from a number of existing Features, as newFeatureFrom does for one feature. The data is loaded and the coverage is locked
+     * only once and whether the geometries must be transformed is decided once for all features, which makes this the way to copy many features.
+     *
+     * @param existingFeatures the features that should be used as templates
+     * @param csySource the coordinate system of the existing features
+     * @return the new features, in the order of the existing features
+     */
+    std::vector<SPFeatureI> newFeaturesFrom(const std::vector<SPFeatureI> &existingFeatures, const Ilwis::ICoordinateSystem &csySource=ICoordinateSystem());
 
     /**
      * Counts the amount of features of a given type in this FeatureCoverage, if you use the default value all features will be counted.
@@ -180,6 +198,38 @@ public:
     const UPGeomFactory &geomfactory() const;
     bool prepare();
     std::vector<quint32> select(const QString& spatialQuery) const;
+    /**
+     * Selects the features whose envelope intersects the given envelope
+     *
+     * @param envelope the envelope to select with, in the coordinate system of this coverage
+     * @return sorted positions of the selected features (the same positions as used by the FeatureIterator)
+     */
+    std::vector<quint32> select(const Envelope& envelope);
+    /**
+     * Selects the features that satisfy a spatial relation with a geometry and optionally an (attribute) predicate. Only features that
+     * pass the spatial index and the relation are offered to the predicate
+     *
+     * @param geometry the query geometry, in the coordinate system of this coverage
+     * @param relation the relation between the features and the query geometry
+     * @param selected receives the sorted positions of the selected features
+     * @param predicate optional additional condition on the features
+     * @return false if the relation could not be evaluated (e.g. invalid geometries); selected is then empty
+     */
+    bool select(const geos::geom::Geometry *geometry, SpatialRelation relation, std::vector<quint32>& selected, const FeaturePredicate& predicate=FeaturePredicate());
+    /**
+     * Selects the features that satisfy a predicate, usually a condition on attribute values
+     *
+     * @param predicate the condition on the features
+     * @return sorted positions of the selected features
+     */
+    std::vector<quint32> selectAttributes(const FeaturePredicate& predicate);
+    /**
+     * Returns the spatial index of the features of this coverage. The index is built on first use and dropped when features
+     * are added or their geometries change. The returned index is a snapshot that stays valid for its user even when the coverage drops it.
+     *
+     * @return the spatial index of the level 0 features
+     */
+    SPFeatureSpatialIndex spatialIndex();
 protected:
     void copyTo(IlwisObject *obj);
 private:
@@ -192,10 +242,14 @@ private:
     UPGeomFactory _geomfactory;
     std::mutex _loadmutex;
     std::mutex _mutex2;
+    std::mutex _indexmutex;
+    SPFeatureSpatialIndex _spatialIndex;
 
 
     Ilwis::FeatureInterface *createNewFeature(IlwisTypes tp);
+    SPFeatureI copyFeature(const SPFeatureI &existingFeature, const ICoordinateSystem &csySource, bool transform);
     void adaptFeatureCounts(int tp, qint32 featureCnt, quint32 level);
+    void invalidateSpatialIndex();
 };
 
 typedef IlwisData<FeatureCoverage> IFeatureCoverage;
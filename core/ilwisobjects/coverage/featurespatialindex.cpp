@@ -0,0 +1,66 @@
+#include "kernel.h"
+#include "coverage.h"
+#include "table.h"
+#include "featurecoverage.h"
+#include "feature.h"
+#include "geos/geom/Envelope.h"
+#include "geos/geom/Geometry.h"
+#include "geos/index/strtree/STRtree.h"
+#include "featurespatialindex.h"
+
+using namespace Ilwis;
+
+FeatureSpatialIndex::FeatureSpatialIndex(const Features &features) : _features(features)
+{
+    // the tree stores pointers to the envelopes and to the positions; both vectors must not reallocate after this point
+    _envelopes.reserve(_features.size());
+    _positions.reserve(_features.size());
+    for(quint32 i = 0; i < _features.size(); ++i){
+        const SPFeatureI& feature = _features[i];
+        if ( !feature)
+            continue;
+        const SPGeometry& geom = feature->geometry();
+        if ( !geom || geom->isEmpty())
+            continue;
+        _envelopes.push_back(*geom->getEnvelopeInternal());
+        _positions.push_back(i);
+    }
+    if ( _positions.size() == 0)
+        return;
+
+    _tree.reset(new geos::index::strtree::STRtree());
+    for(quint32 i = 0; i < _positions.size(); ++i){
+        _tree->insert(&_envelopes[i], &_positions[i]);
+    }
+    _tree->build(); // after building the tree is only read, so it can be queried from several threads
+}
+
+FeatureSpatialIndex::~FeatureSpatialIndex()
+{
+}
+
+std::vector<quint32> FeatureSpatialIndex::candidates(const geos::geom::Envelope &env) const
+{
+    std::vector<quint32> result;
+    if ( !_tree || env.isNull())
+        return result;
+
+    std::vector<void *> items;
+    _tree->query(&env, items);
+    result.reserve(items.size());
+    for(void *item : items)
+        result.push_back(*static_cast<quint32 *>(item));
+    std::sort(result.begin(), result.end());
+
+    return result;
+}
+
+const SPFeatureI &FeatureSpatialIndex::feature(quint32 index) const
+{
+    return _features[index];
+}
+
+quint32 FeatureSpatialIndex::featureCount() const
+{
+    return _features.size();
+}
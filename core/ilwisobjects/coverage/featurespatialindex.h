@@ -0,0 +1,55 @@
+#ifndef FEATURESPATIALINDEX_H
+#define FEATURESPATIALINDEX_H
+
+#include <memory>
+#include "kernel_global.h"
+
+namespace geos{
+namespace geom{
+class Envelope;
+}
+namespace index {
+namespace strtree {
+class STRtree;
+}
+}
+}
+
+namespace Ilwis {
+
+class SPFeatureI;
+typedef std::vector<SPFeatureI> Features;
+
+/*!
+ * \brief The FeatureSpatialIndex class is a STR packed R-tree over the envelopes of the (level 0) features of a feature coverage
+ *
+ * The index is a snapshot; it is built once from the features and never changed. The feature coverage drops its index when
+ * features are added or geometries are changed and builds a new one on demand. The features in the index are identified by their
+ * position in the coverage (the same position as used by the FeatureIterator).
+ */
+class KERNELSHARED_EXPORT FeatureSpatialIndex
+{
+public:
+    FeatureSpatialIndex(const Features& features);
+    ~FeatureSpatialIndex();
+
+    /*!
+     * \brief candidates returns the positions of all features whose envelope intersects the given envelope
+     * \param env envelope to query with
+     * \return sorted list of feature positions
+     */
+    std::vector<quint32> candidates(const geos::geom::Envelope& env) const;
+    const SPFeatureI& feature(quint32 index) const;
+    quint32 featureCount() const;
+
+private:
+    Features _features;
+    std::vector<geos::geom::Envelope> _envelopes; // the tree refers to these envelopes, they must outlive the tree
+    std::vector<quint32> _positions;
+    std::unique_ptr<geos::index::strtree::STRtree> _tree;
+};
+
+typedef std::shared_ptr<FeatureSpatialIndex> SPFeatureSpatialIndex;
+}
+
+#endif // FEATURESPATIALINDEX_H
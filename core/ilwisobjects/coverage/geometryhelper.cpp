@@ -38,10 +38,7 @@ geos::geom::Geometry* GeometryHelper::fromWKT(const QString& wkt, const ICoordin
         geos::io::WKTReader reader;
         geos::geom::Geometry* geom = reader.read(wkt.toStdString());
         if (geom){
-            if ( csy.isValid()){
-                GeometryHelper::setCoordinateSystem(geom, csy.ptr());
-            }else
-               GeometryHelper::setCoordinateSystem(geom,0);
+            GeometryHelper::setCoordinateSystem(geom, csy);
 
             return geom;
         }
@@ -80,16 +77,24 @@ void GeometryHelper::transform(geos::geom::Geometry *geom, const ICoordinateSyst
     geom->apply_rw(&trans);
 }
 
-Ilwis::CoordinateSystem* GeometryHelper::getCoordinateSystem(geos::geom::Geometry *geom){
+quint64 GeometryHelper::getCoordinateSystemId(geos::geom::Geometry *geom){
     if ( geom == nullptr)
-        return 0;
+        return i64UNDEF;
     void *ptr = geom->getUserData();
     if (ptr == 0)
-        return 0;
-    return reinterpret_cast<Ilwis::CoordinateSystem *>(ptr);
+        return i64UNDEF;
+    return (quint64)reinterpret_cast<quintptr>(ptr);
 }
 
-void GeometryHelper::setCoordinateSystem(geos::geom::Geometry* geom, Ilwis::CoordinateSystem* csy){
-    geom->setUserData(csy);
+ICoordinateSystem GeometryHelper::getCoordinateSystem(geos::geom::Geometry *geom){
+    ICoordinateSystem csy;
+    quint64 id = getCoordinateSystemId(geom);
+    if ( id != i64UNDEF && mastercatalog()->id2Resource(id).isValid())
+        csy.prepare(id);
+    return csy;
 }
 
+void GeometryHelper::setCoordinateSystem(geos::geom::Geometry* geom, const ICoordinateSystem& csy){
+    // the id is stored and not the object itself; geometries are shared between coverages and may outlive the coordinate system
+    geom->setUserData(csy.isValid() ? reinterpret_cast<void *>((quintptr)csy->id()) : 0);
+}
@@ -27,9 +27,14 @@ class KERNELSHARED_EXPORT GeometryHelper{
 
         static void transform(geos::geom::Geometry* geom, const ICoordinateSystem& source, const ICoordinateSystem& target);
 
-        static Ilwis::CoordinateSystem* getCoordinateSystem(geos::geom::Geometry* geom);
+        /*!
+         * \brief getCoordinateSystemId returns the id of the coordinate system the geometry is tagged with, i64UNDEF if it is untagged
+         */
+        static quint64 getCoordinateSystemId(geos::geom::Geometry* geom);
 
-        static void setCoordinateSystem(geos::geom::Geometry* geom, Ilwis::CoordinateSystem* csy);
+        static Ilwis::ICoordinateSystem getCoordinateSystem(geos::geom::Geometry* geom);
+
+        static void setCoordinateSystem(geos::geom::Geometry* geom, const Ilwis::ICoordinateSystem& csy);
 
         template<typename PointType> static std::vector<PointType> rotate2d(const PointType &center, const Angle& angle, const std::vector<PointType>& inputPoints)
         {
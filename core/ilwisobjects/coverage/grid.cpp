@@ -3,6 +3,7 @@
 #include "connectorinterface.h"
 #include "geometries.h"
 #include "grid.h"
+#include "operationprofiler.h"
 
 using namespace Ilwis;
 GridBlockInternal::GridBlockInternal(quint32 blocknr, quint64 rasterid,quint32 lines , quint32 width) :  _size(Size<>(width, lines,1)),_id(blocknr),_rasterid(rasterid), _initialized(false), _inMemory(false)
@@ -79,6 +80,7 @@ inline bool GridBlockInternal::save2Cache() {
     }
     _initialized = false;
     _data = std::vector<double>();
+    OperationProfiler::count(OperationProfiler::cSWAPS);
 
     return true;
 
@@ -111,6 +113,7 @@ void GridBlockInternal::needData()
     if ( obj.isValid()){
         IRasterCoverage raster = obj.as<RasterCoverage>();
         raster->getData(_id);
+        OperationProfiler::count(OperationProfiler::cBYTESREAD, blockSize() * sizeof(double));
     }
 }
 
@@ -181,6 +184,7 @@ void Grid::clear() {
     _blockSizes =  std::vector<quint32>();
     _offsets = std::vector<std::vector<quint32>>();
     _blockOffsets = std::vector<quint32>();
+    _changed = std::vector<char>();
     _inMemoryIndex = iUNDEF;
     _allInMemory = false;
     _size = Size<>();
@@ -215,6 +219,7 @@ inline double &Grid::value(quint32 block, int offset )  {
 
 
 inline void Grid::setValue(quint32 block, int offset, double v ) {
+    _changed[block] = true;
     if ( _allInMemory ) {
         _blocks[block]->at(offset) = v;
         return ;
@@ -237,6 +242,8 @@ quint32 Grid::blocksPerBand() const {
 }
 
 void Grid::setBlockData(quint32 block, const std::vector<double>& data, bool creation) {
+    if ( !creation)
+        changed(block, true);
     if ( _allInMemory) { // no cache case
         _blocks[block]->fill(data);
         return ;
@@ -248,6 +255,8 @@ void Grid::setBlockData(quint32 block, const std::vector<double>& data, bool cre
 }
 
 char *Grid::blockAsMemory(quint32 block, bool creation) {
+    if ( !creation)
+        changed(block, true);
     if ( _allInMemory) { // no cache case
         GridBlockInternal *du = _blocks[block];
         char * p = du->blockAsMemory();
@@ -270,6 +279,7 @@ void Grid::setBandProperties(RasterCoverage *raster, int n){
     _blocks.resize(newBlocks);
     _blockSizes.resize(newBlocks);
     _blockOffsets.resize(newBlocks);
+    _changed.resize(newBlocks, 0);
     qint32 totalLines = _size.ysize();
 
     for(quint32 block = oldBlocks; block < _blocks.size(); ++block) {
@@ -314,6 +324,7 @@ bool Grid::prepare(RasterCoverage *raster, const Size<> &sz) {
     _blocks.resize(nblocks);
     _blockSizes.resize(nblocks);
     _blockOffsets.resize(nblocks);
+    _changed.resize(nblocks, 0);
     _allInMemory = _blocks.size() <= _inMemoryIndex;
 
     for(quint32 i = 0; i < _blocks.size(); ++i) {
@@ -350,6 +361,7 @@ inline bool Grid::update(quint32 block, bool creation) {
     if ( block >= _blocks.size() ) // illegal, blocknumber is outside the allowed range
         return false;
     if ( !_blocks[block]->inMemory()) { // if not loaded, load it from the temporary storage
+        OperationProfiler::count(OperationProfiler::cCACHEMISSES);
         try{
         if(!_blocks[block]->loadFromCache()){
             return false;
@@ -362,6 +374,8 @@ inline bool Grid::update(quint32 block, bool creation) {
 
         }
     }
+    else
+        OperationProfiler::count(OperationProfiler::cCACHEHITS);
     if ( creation || _cache.size() == 0) { // at create time we want to preserver the original order in memory
 
         if ( _cache.size() > 0 &&  block > _inMemoryIndex ){
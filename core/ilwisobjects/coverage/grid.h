@@ -112,6 +112,19 @@ public:
     void unload(bool uselock=true);
     std::map<quint32, std::vector<quint32> > calcBlockLimits(const IOOptions &options);
     bool isValid() const;
+    /*!
+     * \brief isChanged true if the block may have been modified since its flag was last reset
+     *
+     * Blocks are flagged by setValue, by setBlockData and blockAsMemory outside creation and by the pixel and block iterators when they enter a block.
+     * As iterators are also used for reading, the flag is conservative. Derived data, like the overviews of a raster, use it to know what to update.
+     */
+    bool isChanged(quint32 block) const {
+        return block < _changed.size() && _changed[block] != 0;
+    }
+    void changed(quint32 block, bool yesno) {
+        if ( block < _changed.size())
+            _changed[block] = yesno;
+    }
 protected:
 
 private:
@@ -134,6 +147,7 @@ private:
     quint32 _maxLines;
     std::vector<std::vector<quint32>> _offsets;
     std::vector<quint32> _blockOffsets;
+    std::vector<char> _changed; // char and not bool; flags of different blocks may be set from different threads
     bool _allInMemory = false;
 
 };
@@ -88,6 +88,7 @@ PixelIterator::PixelIterator(PixelIterator&& iter) :
     _z(iter._z),
     _localOffset(iter._localOffset),
     _currentBlock(iter._currentBlock),
+    _flaggedBlock(iter._flaggedBlock),
     _flow(iter._flow),
     _isValid(iter._isValid),
     _endx(iter._endx),
@@ -128,6 +129,7 @@ void PixelIterator::copy(const PixelIterator &iter) {
     _endposition = iter._endposition;
     _localOffset = iter._localOffset;
     _currentBlock = iter._currentBlock;
+    _flaggedBlock = iter._flaggedBlock;
     _selectionPixels  = iter._selectionPixels;
     _selectionIndex = iter._selectionIndex;
     _insideSelection = iter._insideSelection;
@@ -426,6 +428,7 @@ void PixelIterator::initPosition() {
     _currentBlock += _z * _grid->blocksPerBand();
     _linearposition = sz.xsize() * sz.ysize() * _z + linpos;
     _endposition = sz.xsize() * sz.ysize() * sz.zsize();
+    flagBlock();
 
 }
 
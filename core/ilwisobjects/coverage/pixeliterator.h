@@ -448,6 +448,16 @@ protected:
 
     void init();
     void initPosition();
+    /*!
+     * \brief flags the current block of the grid as changed when the iterator has entered it; done per block and not per pixel
+     * as a dereference can't tell a read from a write, so blocks that are only read are flagged as well
+     */
+    void flagBlock() {
+        if ( _currentBlock != _flaggedBlock) {
+            _grid->changed(_currentBlock, true);
+            _flaggedBlock = _currentBlock;
+        }
+    }
     //bool move(int n);
     //bool moveXYZ(int delta) ;
     void copy(const PixelIterator& iter);
@@ -460,6 +470,7 @@ protected:
     qint32 _z = 0;
     qint32 _localOffset = 0;
     qint32 _currentBlock = 0;
+    qint32 _flaggedBlock = -1;
     Flow _flow;
     bool _isValid;
     qint32 _endx;
@@ -491,6 +502,8 @@ protected:
         } else if ( _flow == fYXZ) {
             ok = moveYXZ(n);
         }
+        if ( ok)
+            flagBlock();
 
         return ok;
     }
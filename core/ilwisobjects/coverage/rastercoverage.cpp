@@ -3,6 +3,7 @@
 #include "symboltable.h"
 #include "table.h"
 #include "pixeliterator.h"
+#include "rasteroverviews.h"
 
 using namespace Ilwis;
 
@@ -31,6 +32,7 @@ void RasterCoverage::georeference(const IGeoReference &grf, bool resetData)
     changed(true);
 
     _georef = grf;
+    _overviews.reset(0);
     if ( resetData)
         _grid.reset(0);
     else if ( !_grid || grf->size().twod() != _grid->size().twod() ) {
@@ -314,6 +316,26 @@ void RasterCoverage::getData(quint32 blockIndex)
     }
 }
 
+IRasterCoverage RasterCoverage::overview(quint32 level)
+{
+    Locker<> lock(_mutex);
+    if ( !_overviews)
+        _overviews.reset(new RasterOverviews(this));
+    return _overviews->overview(level);
+}
+
+void RasterCoverage::updateOverviews()
+{
+    Locker<> lock(_mutex);
+    if ( _overviews)
+        _overviews->update();
+}
+
+quint32 RasterCoverage::overviewLevels() const
+{
+    return RasterOverviews::levels(size());
+}
+
 void RasterCoverage::size(const Size<> &sz)
 {
     if ( isReadOnly())
@@ -323,6 +345,7 @@ void RasterCoverage::size(const Size<> &sz)
     if (sz.xsize() > 0 && sz.ysize() > 0) {
         changed(true);
         _size = sz;
+        _overviews.reset(0);
         gridRef()->prepare(this, sz);
         if (_georef.isValid())
             _georef->size(sz);
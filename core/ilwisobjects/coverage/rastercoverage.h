@@ -16,6 +16,7 @@ class Resource;
 class Grid;
 class PixelIterator;
 class SubFeatureDefinition;
+class RasterOverviews;
 
 typedef SubFeatureDefinition RasterStackDefinition;
 /*!
@@ -199,6 +200,22 @@ public:
     const UPGrid &grid() const;
     void getData(quint32 blockIndex);
 
+    /*!
+     * \brief overview returns a reduced version of this raster
+     *
+     * The overview of level n has a pixel size of 2^n pixels of this raster and exists only in memory. Overviews are built in one pass over the data
+     * when one is first requested and are brought up to date with the changed blocks of the grid by updateOverviews(). They are meant for previews,
+     * approximate statistics and multi-scale algorithms that don't need the full resolution.
+     * \param level 1 up to overviewLevels()
+     * \return the overview or an invalid raster if there is no overview at that level
+     */
+    IlwisData<RasterCoverage> overview(quint32 level);
+    quint32 overviewLevels() const;
+    /*!
+     * \brief updateOverviews reduces again the parts of the overviews that belong to the changed blocks of the grid; nothing is done if no overview has been requested yet
+     */
+    void updateOverviews();
+
 
 
 protected:
@@ -207,6 +224,7 @@ protected:
 
 private:
     std::unique_ptr<Grid> _grid;
+    std::unique_ptr<RasterOverviews> _overviews;
     DataDefinition _datadefCoverage;
     std::vector<DataDefinition> _datadefBands;
     RasterStackDefinition _bandDefinition;
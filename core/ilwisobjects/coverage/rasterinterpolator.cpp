@@ -4,10 +4,24 @@
 
 using namespace Ilwis;
 
+// number of cells in the local copy of the grid; the window spans full lines when possible as most clients move over lines
+const qint32 TILECELLS = 1 << 18;
+const qint32 MINTILEROWS = 8;
+const qint32 TILEMARGIN = 4;
+
 RasterInterpolator::RasterInterpolator(const IRasterCoverage& raster, int method) : _gcoverage(raster), _grid(_gcoverage->grid()),_method(method)  {
 
     _grf = _gcoverage->georeference();
     _valid = _grf.isValid() && _grid != 0;
+    if ( _valid)
+        _transform = _grf->transform();
+    if ( _valid && _method != ipNEARESTNEIGHBOUR){
+        Size<> sz = _grid->size();
+        // margin on each side for the bicubic neighbourhood of pixels just outside the grid
+        _tileCols = std::min((qint32)sz.xsize() + 2 * TILEMARGIN, TILECELLS / MINTILEROWS);
+        _tileRows = std::max(MINTILEROWS, std::min((qint32)sz.ysize() + 2 * TILEMARGIN, TILECELLS / _tileCols));
+        _tile.resize(_tileCols * _tileRows);
+    }
 }
 
 double RasterInterpolator::pix2value(const Pixeld& pix) {
@@ -28,31 +42,115 @@ double RasterInterpolator::coord2value(const Coordinate &crd, quint32 z)
 {
      if (!_valid || !crd.isValid())
         return rUNDEF;
-     Pixeld pix = _grf->coord2Pixel(crd);
+     Pixeld pix = _transform.coord2Pixel(crd);
      pix.z = z;
      return pix2value(pix);
 }
 
+void RasterInterpolator::pix2value(const std::vector<Pixeld> &pixels, std::vector<double> &values)
+{
+    values.resize(pixels.size());
+    switch( _method) {
+    case 0:
+        for(quint32 i = 0; i < pixels.size(); ++i)
+            values[i] = _grid->value(pixels[i]);
+        break;
+    case 1:
+        for(quint32 i = 0; i < pixels.size(); ++i)
+            values[i] = bilinear(pixels[i]);
+        break;
+    case 2:
+        for(quint32 i = 0; i < pixels.size(); ++i)
+            values[i] = bicubic(pixels[i]);
+        break;
+    default:
+        std::fill(values.begin(), values.end(), rUNDEF);
+    }
+}
+
+void RasterInterpolator::coord2value(const std::vector<Coordinate> &crds, quint32 z, std::vector<double> &values)
+{
+    if (!_valid){
+        values.assign(crds.size(), rUNDEF);
+        return;
+    }
+    std::vector<Pixeld> pixels(crds.size());
+    for(quint32 i = 0; i < crds.size(); ++i) {
+        if ( crds[i].isValid()){
+            pixels[i] = _transform.coord2Pixel(crds[i]);
+            pixels[i].z = z;
+        }
+    }
+    pix2value(pixels, values);
+    for(quint32 i = 0; i < crds.size(); ++i) {
+        if (!crds[i].isValid())
+            values[i] = rUNDEF;
+    }
+}
+
+bool RasterInterpolator::inTile(qint32 colmin, qint32 rowmin, qint32 colmax, qint32 rowmax, qint32 z) const
+{
+    return z == _tileZ &&
+           colmin >= _tileCol && colmax < _tileCol + _tileCols &&
+           rowmin >= _tileRow && rowmax < _tileRow + _tileRows;
+}
+
+void RasterInterpolator::loadTile(qint32 colmin, qint32 rowmin, qint32 z)
+{
+    Size<> sz = _grid->size();
+    qint32 xsize = sz.xsize();
+    qint32 ysize = sz.ysize();
+    _tileCol = _tileCols >= xsize + 2 * TILEMARGIN ? -TILEMARGIN : colmin;
+    _tileRow = rowmin;
+    _tileZ = z;
+    std::fill(_tile.begin(), _tile.end(), rUNDEF);
+    if ( z < 0 || z >= sz.zsize())
+        return;
+
+    qint32 xstart = std::max(0, _tileCol);
+    qint32 xend = std::min(xsize, _tileCol + _tileCols);
+    qint32 ystart = std::max(0, _tileRow);
+    qint32 yend = std::min(ysize, _tileRow + _tileRows);
+    quint32 bandBlocks = _grid->blocksPerBand() * z;
+    qint32 maxLines = _grid->maxLines();
+    for(qint32 y = ystart; y < yend; ++y) {
+        quint32 block = bandBlocks + y / maxLines;
+        qint32 lineOffset = (y % maxLines) * xsize;
+        double *target = &_tile[(y - _tileRow) * _tileCols + xstart - _tileCol];
+        for(qint32 x = xstart; x < xend; ++x) {
+            *target++ = _grid->value(block, lineOffset + x);
+        }
+    }
+}
+
+bool RasterInterpolator::outside(const Pixeld &pix) const
+{
+    // pixels that have no neighbours inside the grid; this also keeps the pixel numbers well within the integer range
+    Size<> sz = _grid->size();
+    return !pix.isValid() || pix.x < -2 || pix.y < -2 || pix.x > sz.xsize() + 2 || pix.y > sz.ysize() + 2;
+}
+
 double RasterInterpolator::bilinear(const Pixeld& pix) {
+    if ( outside(pix))
+        return rUNDEF;
     double y = pix.y - 0.5;
     double x = pix.x - 0.5;
 
-    _nbrows[1] = _nbrows[0] = (int)y;
-    _nbrows[3] = _nbrows[2] = _nbrows[1] + 1;
-    _nbcols[2] = _nbcols[0] = (int)x;
-    _nbcols[3] = _nbcols[1] = _nbcols[0] + 1;
-    double deltaY = y - _nbrows[0];
-    double deltaX = x - _nbcols[0];
-    _weight[0] = (1 - deltaY) * (1 - deltaX);
-    _weight[1] = (1 - deltaY) * deltaX;
-    _weight[2] = deltaY * (1 - deltaX);
-    _weight[3] = deltaY * deltaX;
+    qint32 row = (int)y;
+    qint32 column = (int)x;
+    qint32 z = pix.is3D() ? pix.z : 0;
+    if ( !inTile(column, row, column + 1, row + 1, z))
+        loadTile(column - 1, row - 1, z);
+
+    double deltaY = y - row;
+    double deltaX = x - column;
+    double weights[4] = {(1 - deltaY) * (1 - deltaX), (1 - deltaY) * deltaX, deltaY * (1 - deltaX), deltaY * deltaX};
+    double values[4] = {tileValue(column, row), tileValue(column + 1, row), tileValue(column, row + 1), tileValue(column + 1, row + 1)};
     double tot_weight=0.0, totValue=0.0;
     for (int i = 0; i < 4; ++i) {
-        double rVal = _grid->value({_nbcols[i],_nbrows[i], pix.z});
-        if (rVal != rUNDEF) {
-            totValue +=  rVal * _weight[i];
-            tot_weight += _weight[i];
+        if (values[i] != rUNDEF) {
+            totValue +=  values[i] * weights[i];
+            tot_weight += weights[i];
         }
     }
     if (tot_weight < 0.1)
@@ -64,21 +162,68 @@ double RasterInterpolator::bilinear(const Pixeld& pix) {
 
 double RasterInterpolator::bicubic(const Pixeld &pix)
 {
+    if ( outside(pix))
+        return rUNDEF;
     double y = pix.y - 0.5;
     double x = pix.x - 0.5;
-    long column = (long)x;
-    long row = (long)y;
+    qint32 column = (qint32)x;
+    qint32 row = (qint32)y;
+    qint32 z = pix.is3D() ? pix.z : 0;
+    if ( !inTile(column - 1, row - 1, column + 2, row + 2, z))
+        loadTile(column - 2, row - 2, z);
+
     double deltaY = y - row;
     double deltaX = x - column;
-    for(short i=0; i<4; ++i)
-        _yvalues[i]=bicubicResult(row-1+i, column, pix.z, deltaX);
-    if(resolveRealUndefs(_yvalues))
-      return bicubicPolynom(_yvalues, deltaY);
+    double xweights[4];
+    double yweights[4];
+    bicubicWeights(deltaX, xweights);
+    bicubicWeights(deltaY, yweights);
+
+    // fast path; with a complete neighbourhood the polynomials reduce to fixed weights
+    const double *lines[4];
+    bool complete = true;
+    for(int j = 0; j < 4 && complete; ++j) {
+        lines[j] = &_tile[(row - 1 + j - _tileRow) * _tileCols + column - 1 - _tileCol];
+        for(int i = 0; i < 4; ++i)
+            complete = complete && lines[j][i] != rUNDEF;
+    }
+    if ( complete) {
+        double result = 0;
+        for(int j = 0; j < 4; ++j) {
+            const double *line = lines[j];
+            result += yweights[j] * (xweights[0] * line[0] + xweights[1] * line[1] + xweights[2] * line[2] + xweights[3] * line[3]);
+        }
+        return result;
+    }
 
+    double yvalues[4];
+    for(int j = 0; j < 4; ++j) {
+        double xvalues[4];
+        yvalues[j] = rUNDEF;
+        if ( row - 1 + j >= (qint32)_grid->size().ysize())
+            continue;
+        for(int i = 0; i < 4; ++i)
+            xvalues[i] = tileValue(column - 1 + i, row - 1 + j);
+        if ( resolveRealUndefs(xvalues))
+            yvalues[j] = bicubicPolynom(xvalues, deltaX);
+    }
+    if(resolveRealUndefs(yvalues))
+      return bicubicPolynom(yvalues, deltaY);
 
     return rUNDEF;
 }
 
+void RasterInterpolator::bicubicWeights(double delta, double weights[]) const
+{
+    // coefficients of the values in bicubicPolynom
+    double delta2 = delta * delta;
+    double delta3 = delta2 * delta;
+    weights[0] = -delta / 3 + delta2 / 2 - delta3 / 6;
+    weights[1] = 1 - delta / 2 - delta2 + delta3 / 2;
+    weights[2] = delta + delta2 / 2 - delta3 / 2;
+    weights[3] = -delta / 6 + delta3 / 6;
+}
+
 double RasterInterpolator::bicubicPolynom(double values[], const double& delta)
 {
     double result = values[1] +
@@ -88,20 +233,6 @@ double RasterInterpolator::bicubicPolynom(double values[], const double& delta)
     return result;
 }
 
-double RasterInterpolator::bicubicResult(long row, long column, long z, const double& deltaCol)
-{
-  long i;
-  if ( row >= _gcoverage->size().ysize())
-       return rUNDEF;
-  for( i=0; i<4; ++i){
-      _xvalues[i]= _grid->value({column-1L+i,row, z});
-  }
-  if(resolveRealUndefs(_xvalues))
-    return bicubicPolynom(_xvalues, deltaCol);
-
-  return rUNDEF;
-}
-
 bool RasterInterpolator::resolveRealUndefs(double values[])
 {
     if ( values[1]==rUNDEF){
@@ -119,4 +250,3 @@ bool RasterInterpolator::resolveRealUndefs(double values[])
 
     return true;
 }
-
@@ -4,6 +4,13 @@
 namespace Ilwis {
 class Grid;
 
+/*!
+ * \brief The RasterInterpolator class computes (interpolated) values at non integer pixel locations of a raster
+ *
+ * Bilinear and bicubic interpolation work on a local copy of a window of the input grid (the tile). Neighbour values are read from
+ * this window instead of through the grid so that every input pixel is fetched from the grid only once per window. The batch versions
+ * of pix2value and coord2value are the preferred way of using the interpolator in loops as they reuse the window and the scratch space.
+ */
 class KERNELSHARED_EXPORT RasterInterpolator
 {
 public:
@@ -12,21 +19,34 @@ public:
     RasterInterpolator(const IRasterCoverage& raster, int method) ;
     double pix2value(const Pixeld &pix);
     double coord2value(const Coordinate& crd, quint32 z);
+    void pix2value(const std::vector<Pixeld>& pixels, std::vector<double>& values);
+    void coord2value(const std::vector<Coordinate>& crds, quint32 z, std::vector<double>& values);
 
 private:
     double bilinear(const Pixeld &pix) ;
     double bicubic(const Pixeld &pix) ;
     double bicubicPolynom(double values[], const double &delta);
-    double bicubicResult(long row, long column, long z, const double &deltaCol);
     bool resolveRealUndefs(double values[]);
-    long _nbrows[4], _nbcols[4];
-    double _weight[4];
-    double _yvalues[4], _xvalues[4];
+    void bicubicWeights(double delta, double weights[]) const;
+    bool outside(const Pixeld& pix) const;
+    bool inTile(qint32 colmin, qint32 rowmin, qint32 colmax, qint32 rowmax, qint32 z) const;
+    void loadTile(qint32 colmin, qint32 rowmin, qint32 z);
+    double tileValue(qint32 col, qint32 row) const {
+        return _tile[(row - _tileRow) * _tileCols + col - _tileCol];
+    }
+
     IRasterCoverage _gcoverage;
     const UPGrid &_grid; // for peformance reason we store this; will be valid aslong as the coverage is there
     IGeoReference _grf;
+    GeoRefTransform _transform;
     int _method;
     bool _valid;
+    std::vector<double> _tile;
+    qint32 _tileCol = 0;
+    qint32 _tileRow = 0;
+    qint32 _tileZ = iUNDEF;
+    qint32 _tileCols = 0;
+    qint32 _tileRows = 0;
 };
 }
 
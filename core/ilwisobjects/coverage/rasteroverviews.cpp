@@ -0,0 +1,184 @@
+#include "raster.h"
+#include "pixeliterator.h"
+#include "rasteroverviews.h"
+
+using namespace Ilwis;
+
+RasterOverviews::RasterOverviews(RasterCoverage *raster) : _raster(raster)
+{
+}
+
+quint32 RasterOverviews::levels(const Size<> &sz)
+{
+    if ( !sz.isValid() || sz.isNull())
+        return 0;
+    quint32 side = std::max(sz.xsize(), sz.ysize());
+    quint32 count = 0;
+    while ( side > MINOVERVIEWSIZE){
+        side = (side + 1) / 2;
+        ++count;
+    }
+    return count;
+}
+
+IRasterCoverage RasterOverviews::overview(quint32 level)
+{
+    Locker<> lock(_mutex);
+    if ( level == 0 || level > levels(_raster->size()))
+        return IRasterCoverage();
+
+    if ( _levels.size() == 0 || _baseSize != _raster->size()){
+        if (!build())
+            return IRasterCoverage();
+    }
+
+    return _levels[level - 1];
+}
+
+bool RasterOverviews::build()
+{
+    _levels.clear();
+    const IGeoReference& grf = _raster->georeference();
+    if ( !grf.isValid())
+        return ERROR2(ERR_NO_INITIALIZED_2, "georeference", _raster->name());
+
+    IlwisTypes domainType = _raster->datadef().domain<>()->ilwisType();
+    _method = domainType == itNUMERICDOMAIN ? mMEAN : (domainType == itITEMDOMAIN ? mMODE : mNEAREST);
+    _baseSize = _raster->size();
+
+    quint32 count = levels(_baseSize);
+    for(quint32 level = 1; level <= count; ++level){
+        qint32 factor = 1 << level;
+        Size<> sz((_baseSize.xsize() + factor - 1) / factor, (_baseSize.ysize() + factor - 1) / factor, _baseSize.zsize());
+        // the last row and column may cover (partly) non existing pixels of the raster
+        Envelope env = grf->pixel2Coord(BoundingBox(Pixel(0,0), Pixel(sz.xsize() * factor - 1, sz.ysize() * factor - 1)));
+        QString grfs = QString("code=georef:type=corners,csy=%1,envelope=%2,gridsize=%3")
+                .arg(_raster->coordinateSystem()->id())
+                .arg(env.toString())
+                .arg(sz.twod().toString());
+        IRasterCoverage raster;
+        if (!raster.prepare()){
+            _levels.clear();
+            return ERROR1(ERR_COULDNT_CREATE_OBJECT_FOR_1, "overview");
+        }
+        raster->coordinateSystem(_raster->coordinateSystem());
+        raster->georeference(grfs);
+        raster->datadefRef() = _raster->datadef();
+        raster->size(sz);
+        raster->envelope(env);
+        if ( raster->size() != sz){
+            _levels.clear();
+            return ERROR1(ERR_COULDNT_CREATE_OBJECT_FOR_1, "overview");
+        }
+        _levels.push_back(raster);
+    }
+    // blocks loaded during the build are not changes
+    const UPGrid& grid = _raster->gridRef();
+    for(quint32 block = 0; block < grid->blocks(); ++block)
+        grid->changed(block, false);
+    for(qint32 z = 0; z < _baseSize.zsize(); ++z)
+        refresh(0, _baseSize.ysize() - 1, z);
+    for(quint32 block = 0; block < grid->blocks(); ++block)
+        grid->changed(block, false);
+
+    return true;
+}
+
+void RasterOverviews::update()
+{
+    Locker<> lock(_mutex);
+    if ( _levels.size() == 0 || _baseSize != _raster->size())
+        return; // (re)built completely when an overview is requested
+    const UPGrid& grid = _raster->gridRef();
+    quint32 blocksPerBand = grid->blocksPerBand();
+    if ( blocksPerBand == 0)
+        return;
+    qint32 linesPerBlock = grid->maxLines();
+    qint32 ymin = iUNDEF, ymax = iUNDEF, zrange = iUNDEF;
+    // adjacent changed blocks are refreshed as one range of rows
+    for(quint32 block = 0; block < grid->blocks(); ++block){
+        if ( !grid->isChanged(block))
+            continue;
+        grid->changed(block, false);
+        qint32 z = block / blocksPerBand;
+        qint32 first = (block % blocksPerBand) * linesPerBlock;
+        qint32 last = std::min(first + linesPerBlock, (qint32)_baseSize.ysize()) - 1;
+        if ( zrange == z && ymax + 1 == first){
+            ymax = last;
+            continue;
+        }
+        if ( zrange != iUNDEF)
+            refresh(ymin, ymax, zrange);
+        ymin = first;
+        ymax = last;
+        zrange = z;
+    }
+    if ( zrange != iUNDEF)
+        refresh(ymin, ymax, zrange);
+}
+
+void RasterOverviews::refresh(qint32 ymin, qint32 ymax, qint32 z)
+{
+    RasterCoverage *source = _raster;
+    for(IRasterCoverage& level : _levels){
+        ymin /= 2;
+        ymax /= 2;
+        reduce(source, level, ymin, ymax, z);
+        source = level.ptr();
+    }
+}
+
+void RasterOverviews::reduce(RasterCoverage *source, IRasterCoverage &target, qint32 ymin, qint32 ymax, qint32 z) const
+{
+    Size<> sourceSize = source->size();
+    Size<> targetSize = target->size();
+    const UPGrid& grid = source->gridRef();
+    std::vector<double> upper(targetSize.xsize() * 2, rUNDEF);
+    std::vector<double> lower(targetSize.xsize() * 2, rUNDEF);
+    for(qint32 y = ymin; y <= ymax; ++y){
+        // reading through the grid doesn't flag the blocks of the source as changed
+        for(qint32 x = 0; x < sourceSize.xsize(); ++x){
+            upper[x] = grid->value(Pixel(x, 2 * y, z));
+            lower[x] = 2 * y + 1 < sourceSize.ysize() ? grid->value(Pixel(x, 2 * y + 1, z)) : rUNDEF;
+        }
+        PixelIterator iter(target, BoundingBox(Pixel(0, y, z), Pixel(targetSize.xsize() - 1, y, z)));
+        for(qint32 x = 0; x < targetSize.xsize(); ++x, ++iter){
+            double values[4] = {upper[2 * x], upper[2 * x + 1], lower[2 * x], lower[2 * x + 1]};
+            *iter = combine(values, 4);
+        }
+    }
+}
+
+double RasterOverviews::combine(double *values, int n) const
+{
+    if ( _method == mNEAREST)
+        return values[0];
+
+    if ( _method == mMEAN){
+        double sum = 0;
+        int count = 0;
+        for(int i = 0; i < n; ++i){
+            if ( !isNumericalUndef(values[i])){
+                sum += values[i];
+                ++count;
+            }
+        }
+        return count == 0 ? rUNDEF : sum / count;
+    }
+    // mode; on a tie the first value wins
+    double result = rUNDEF;
+    int maxCount = 0;
+    for(int i = 0; i < n; ++i){
+        if ( isNumericalUndef(values[i]))
+            continue;
+        int count = 1;
+        for(int j = i + 1; j < n; ++j)
+            if ( values[j] == values[i])
+                ++count;
+        if ( count > maxCount){
+            maxCount = count;
+            result = values[i];
+        }
+    }
+    return result;
+}
@@ -0,0 +1,63 @@
+#ifndef RASTEROVERVIEWS_H
+#define RASTEROVERVIEWS_H
+
+#include <mutex>
+#include <vector>
+#include "kernel_global.h"
+
+namespace Ilwis {
+
+class RasterCoverage;
+typedef IlwisData<RasterCoverage> IRasterCoverage;
+
+/*!
+ * \brief The RasterOverviews class maintains reduced versions (overviews) of a raster coverage
+ *
+ * Overview level n has a pixel size of 2^n pixels of the raster; level 0 is the raster itself. Levels are added until the larger side of a level is not
+ * larger than MINOVERVIEWSIZE. A pixel of a level combines 2x2 pixels of the level before it: the mean for numeric domains, the most frequent value for
+ * item domains and the upper left pixel for other domains. Each level is reduced from the previous one, so building all levels reads the raster data
+ * only once. As a consequence the means of the higher levels are means of means.
+ *
+ * The overviews are built when they are first requested. update() reduces again the rows of the blocks of the raster that have been flagged as changed in
+ * its grid. It is not done on every request, as the flags are conservative (blocks read through a non-const iterator are flagged as well); users such as
+ * the drawers update once when they prepare and then request overviews as often as they need.
+ */
+class KERNELSHARED_EXPORT RasterOverviews
+{
+public:
+    enum Method{mMEAN, mMODE, mNEAREST};
+
+    static const quint32 MINOVERVIEWSIZE = 256;
+
+    RasterOverviews(RasterCoverage *raster);
+
+    /*!
+     * \brief overview the overview at a level
+     * \param level 1 (a reduction of 2x) up to levels()
+     * \return the overview or an invalid coverage if the level doesn't exist
+     */
+    IRasterCoverage overview(quint32 level);
+    /*!
+     * \brief levels the number of overview levels of a raster of the given size
+     */
+    static quint32 levels(const Size<>& sz);
+    /*!
+     * \brief update brings overviews that have been built up to date with the blocks of the raster that changed since the last build or update
+     */
+    void update();
+
+private:
+    bool build();
+    void reduce(RasterCoverage *source, IRasterCoverage &target, qint32 ymin, qint32 ymax, qint32 z) const;
+    void refresh(qint32 ymin, qint32 ymax, qint32 z);
+    double combine(double *values, int n) const;
+
+    RasterCoverage *_raster;
+    Method _method = mNEAREST;
+    Size<> _baseSize;
+    std::vector<IRasterCoverage> _levels;
+    std::recursive_mutex _mutex;
+};
+}
+
+#endif // RASTEROVERVIEWS_H
@@ -43,6 +43,12 @@ VertexIterator::VertexIterator(geos::geom::Geometry *geom)
     setFromGeometry(geom);
 }
 
+VertexIterator::VertexIterator(const geos::geom::Geometry *geom)
+{
+    // setFromGeometry only reads the geometry; the coordinates are kept as const sequences
+    setFromGeometry(const_cast<geos::geom::Geometry *>(geom));
+}
+
 VertexIterator &VertexIterator::operator=(const VertexIterator &iter)
 {
     _coordinates = iter._coordinates;
@@ -25,6 +25,10 @@ class KERNELSHARED_EXPORT VertexIterator : public std::iterator<std::random_acce
 public:
     VertexIterator();
     VertexIterator(geos::geom::Geometry *geom);
+    /*!
+     * \brief VertexIterator iterates over the vertices of a geometry that may only be read, e.g. one that is shared by several features
+     */
+    VertexIterator(const geos::geom::Geometry *geom);
     VertexIterator(const UPGeometry &geom);
     VertexIterator(const QString& wkt);
     VertexIterator(const VertexIterator& iter);
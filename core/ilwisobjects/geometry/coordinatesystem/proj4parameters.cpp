@@ -4,8 +4,13 @@
 #include <QDebug>
 #include "ilwis.h"
 #include "kernel_global.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include "kernel.h"
 #include "proj4parameters.h"
 
+using namespace Ilwis;
+
 std::multimap<quint32, Proj4Def> Proj4Parameters::_lookup;
 
 Proj4Parameters::Proj4Parameters( const QString& p) : _hasDatum(false)
@@ -91,6 +96,18 @@ bool Proj4Parameters::operator==(const Proj4Parameters &parms) const
     return true;
 }
 
+void Proj4Parameters::fillLookup(const QSqlDatabase &database) {
+    QSqlQuery db(database);
+    if (!db.exec("SELECT code, name, proj_params FROM projectedcsy")) {
+        kernel()->issues()->logSql(db.lastError());
+        return;
+    }
+    while(db.next()) {
+        QString proj4def = db.value(2).toString();
+        _lookup.insert(std::pair<quint32, Proj4Def>(hash(proj4def),{db.value(1).toString(), proj4def, db.value(0).toString()}));
+    }
+}
+
 Proj4Def Proj4Parameters::lookupDefintion(const QString& proj4Def) {
     quint32 hasv = Proj4Parameters::hash(proj4Def);
     auto iter = _lookup.find(hasv);
@@ -3,6 +3,8 @@
 
 #include <map>
 
+class QSqlDatabase;
+
 struct Proj4Def{
     Proj4Def(const QString& name=sUNDEF, const QString& proj4def=sUNDEF, const QString epsg=sUNDEF) : _proj4def(proj4def), _name(name), _epsg(epsg){}
     QString _proj4def;
@@ -21,6 +23,13 @@ public:
 
     static void add2lookup(const QString &name, const QString &proj4def, const QString epsg);
     static Proj4Def lookupDefintion(const QString &proj4Def);
+    /*!
+     * \brief fillLookup builds the proj4 to epsg lookup from the projectedcsy table
+     *
+     * It is called once while the public database is prepared; sql connections can only be used by the thread that made them, so
+     * the lookup can't be filled by whichever (worker) thread first needs it.
+     */
+    static void fillLookup(const QSqlDatabase& database);
 private:
     static quint32 hash(QString code);
     void parseShifts(const QString &shifts);
@@ -53,6 +53,13 @@ Pixeld GeoReference::coord2Pixel(const Coordinate &crd) const
     return _georefImpl->coord2Pixel(crd);
 }
 
+GeoRefTransform GeoReference::transform() const
+{
+    if ( !isValid())
+        return GeoRefTransform();
+    return _georefImpl->transform();
+}
+
 double GeoReference::pixelSize() const
 {
     // for performance reasons no isValid check here, haas tobe checked before hand
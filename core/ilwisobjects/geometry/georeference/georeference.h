@@ -3,6 +3,7 @@
 
 #include "kernel_global.h"
 #include "georefadapter.h"
+#include "georeftransform.h"
 
 namespace Ilwis {
 
@@ -36,6 +37,13 @@ public:
     double pixelSize() const;
     bool compute();
 
+    /*!
+     * \brief transform returns a transform object for fast (repeated) pixel/coordinate conversions
+     *
+     * The transform is only valid as long as this georeference exists and is unchanged.
+     * \return a transform; affine for georeferences that are a fixed affine mapping
+     */
+    GeoRefTransform transform() const;
     virtual Envelope pixel2Coord(const BoundingBox &box ) const;
     virtual BoundingBox coord2Pixel(const Envelope &box) const;
     ICoordinateSystem coordinateSystem() const;
@@ -61,3 +61,8 @@ bool GeoRefImplementation::isCompatible(const IGeoReference &georefOther) const
 {
     return false;
 }
+
+GeoRefTransform GeoRefImplementation::transform() const
+{
+    return GeoRefTransform(this);
+}
@@ -15,6 +15,7 @@ public:
     void centerOfPixel(bool yesno);
     bool compute();
     virtual bool isCompatible(const IGeoReference &georefOther) const;
+    virtual GeoRefTransform transform() const;
 protected:
 
     ICoordinateSystem _csy;
@@ -0,0 +1,100 @@
+#include "kernel.h"
+#include "geometries.h"
+#include "ilwisdata.h"
+#include "coordinatesystem.h"
+#include "georeference.h"
+#include "georeftransform.h"
+
+using namespace Ilwis;
+
+GeoRefTransform::GeoRefTransform()
+{
+}
+
+GeoRefTransform::GeoRefTransform(const GeoRefInterface *georef) : _georef(georef)
+{
+}
+
+GeoRefTransform::GeoRefTransform(const std::vector<double> &pixel2coord, const std::vector<double> &coord2pixel) : _affine(true)
+{
+    if ( pixel2coord.size() != 6 || coord2pixel.size() != 6){
+        _affine = false;
+        return;
+    }
+    std::copy(pixel2coord.begin(), pixel2coord.end(), _p2c);
+    std::copy(coord2pixel.begin(), coord2pixel.end(), _c2p);
+}
+
+bool GeoRefTransform::isValid() const
+{
+    return _affine || _georef != 0;
+}
+
+bool GeoRefTransform::isAffine() const
+{
+    return _affine;
+}
+
+void GeoRefTransform::pixel2Coord(const std::vector<Pixeld> &pixels, std::vector<Coordinate> &crds) const
+{
+    crds.resize(pixels.size());
+    if ( _affine) {
+        for(quint32 i = 0; i < pixels.size(); ++i) {
+            const Pixeld& pix = pixels[i];
+            crds[i].x = _p2c[0] + _p2c[1] * pix.x + _p2c[2] * pix.y;
+            crds[i].y = _p2c[3] + _p2c[4] * pix.x + _p2c[5] * pix.y;
+        }
+    } else {
+        for(quint32 i = 0; i < pixels.size(); ++i)
+            crds[i] = generalPixel2Coord(pixels[i]);
+    }
+}
+
+void GeoRefTransform::coord2Pixel(const std::vector<Coordinate> &crds, std::vector<Pixeld> &pixels) const
+{
+    pixels.resize(crds.size());
+    if ( _affine) {
+        for(quint32 i = 0; i < crds.size(); ++i) {
+            const Coordinate& crd = crds[i];
+            pixels[i].x = _c2p[0] + _c2p[1] * crd.x + _c2p[2] * crd.y;
+            pixels[i].y = _c2p[3] + _c2p[4] * crd.x + _c2p[5] * crd.y;
+        }
+    } else {
+        for(quint32 i = 0; i < crds.size(); ++i)
+            pixels[i] = generalCoord2Pixel(crds[i]);
+    }
+}
+
+void GeoRefTransform::lineCoordinates(double row, double column, quint32 count, std::vector<Coordinate> &crds) const
+{
+    crds.resize(count);
+    if ( count == 0)
+        return;
+    if ( _affine) {
+        double x = _p2c[0] + _p2c[1] * column + _p2c[2] * row;
+        double y = _p2c[3] + _p2c[4] * column + _p2c[5] * row;
+        for(quint32 i = 0; i < count; ++i) {
+            crds[i].x = x;
+            crds[i].y = y;
+            x += _p2c[1];
+            y += _p2c[4];
+        }
+    } else {
+        for(quint32 i = 0; i < count; ++i)
+            crds[i] = generalPixel2Coord(Pixeld(column + i, row));
+    }
+}
+
+Coordinate GeoRefTransform::generalPixel2Coord(const Pixeld &pix) const
+{
+    if ( _georef == 0)
+        return Coordinate();
+    return _georef->pixel2Coord(pix);
+}
+
+Pixeld GeoRefTransform::generalCoord2Pixel(const Coordinate &crd) const
+{
+    if ( _georef == 0)
+        return Pixeld();
+    return _georef->coord2Pixel(crd);
+}
@@ -0,0 +1,68 @@
+#ifndef GEOREFTRANSFORM_H
+#define GEOREFTRANSFORM_H
+
+#include "kernel_global.h"
+
+namespace Ilwis {
+
+class GeoRefInterface;
+
+/*!
+ * \brief The GeoRefTransform class is a light weight, copyable version of the pixel/coordinate mapping of a georeference meant for use in loops
+ *
+ * Georeferences that are a fixed affine mapping (corners, simple) deliver a transform that evaluates the mapping inline without any virtual calls.
+ * All other georeferences deliver a transform that delegates to the georeference itself. The transform doesn't own the georeference; it is only valid
+ * as long as the georeference it was created from exists and isn't changed.
+ */
+class KERNELSHARED_EXPORT GeoRefTransform
+{
+public:
+    GeoRefTransform();
+    GeoRefTransform(const GeoRefInterface *georef);
+    /*!
+     * \brief GeoRefTransform constructs an affine transform
+     * \param pixel2coord coefficients {x0, dx/dcol, dx/drow, y0, dy/dcol, dy/drow} of the pixel to coordinate mapping
+     * \param coord2pixel coefficients {col0, dcol/dx, dcol/dy, row0, drow/dx, drow/dy} of the coordinate to pixel mapping
+     */
+    GeoRefTransform(const std::vector<double>& pixel2coord, const std::vector<double>& coord2pixel);
+
+    bool isValid() const;
+    bool isAffine() const;
+
+    Coordinate pixel2Coord(const Pixeld& pix) const{
+        if ( _affine)
+            return Coordinate(_p2c[0] + _p2c[1] * pix.x + _p2c[2] * pix.y, _p2c[3] + _p2c[4] * pix.x + _p2c[5] * pix.y);
+        return generalPixel2Coord(pix);
+    }
+
+    Pixeld coord2Pixel(const Coordinate& crd) const{
+        if ( _affine)
+            return Pixeld(_c2p[0] + _c2p[1] * crd.x + _c2p[2] * crd.y, _c2p[3] + _c2p[4] * crd.x + _c2p[5] * crd.y);
+        return generalCoord2Pixel(crd);
+    }
+
+    void pixel2Coord(const std::vector<Pixeld>& pixels, std::vector<Coordinate>& crds) const;
+    void coord2Pixel(const std::vector<Coordinate>& crds, std::vector<Pixeld>& pixels) const;
+    /*!
+     * \brief lineCoordinates computes the coordinates of count consecutive pixels on one line
+     *
+     * For an affine transform only the first coordinate is computed, the others are found by adding the (constant) column step
+     * \param row the row (pixel y) of the line
+     * \param column the column (pixel x) of the first pixel
+     * \param count the number of pixels
+     * \param crds receives the coordinates
+     */
+    void lineCoordinates(double row, double column, quint32 count, std::vector<Coordinate>& crds) const;
+
+private:
+    Coordinate generalPixel2Coord(const Pixeld& pix) const;
+    Pixeld generalCoord2Pixel(const Coordinate& crd) const;
+
+    const GeoRefInterface *_georef = 0;
+    bool _affine = false;
+    double _p2c[6];
+    double _c2p[6];
+};
+}
+
+#endif // GEOREFTRANSFORM_H
@@ -64,6 +64,18 @@ std::vector<double> SimpelGeoReference::support() const {
     return {_b1, _b2};
 }
 
+GeoRefTransform SimpelGeoReference::transform() const
+{
+    if ( _det == 0 || _a11 == rUNDEF)
+        return GeoRefTransform(this);
+
+    // pixel2Coord and coord2Pixel written out as affine coefficients
+    std::vector<double> pixel2coord = {(_a12 * _b2 - _a22 * _b1) / _det, _a22 / _det, -_a12 / _det,
+                                       (_a21 * _b1 - _a11 * _b2) / _det, -_a21 / _det, _a11 / _det};
+    std::vector<double> coord2pixel = {_b1, _a11, _a12, _b2, _a21, _a22};
+    return GeoRefTransform(pixel2coord, coord2pixel);
+}
+
 QString SimpelGeoReference::typeName()
 {
     return "simple";
@@ -14,6 +14,7 @@ public:
     virtual Pixeld coord2Pixel(const Coordinate& crd) const;
     virtual double pixelSize() const;
     bool isCompatible(const IGeoReference &georefOther) const;
+    GeoRefTransform transform() const;
 
     std::vector<double> matrix() const;
     std::vector<double> support() const;
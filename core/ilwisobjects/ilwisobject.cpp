@@ -16,6 +16,7 @@
 #include "ilwiscontext.h"
 #include "catalog.h"
 #include "version.h"
+#include "operationprofiler.h"
 
 
 
@@ -401,7 +402,13 @@ bool IlwisObject::store(const IOOptions &options)
         if (connector() && !connector()->dataIsLoaded()) {
             connector()->loadData(this, options);
         }
-        return connector(cmOUTPUT)->store(this, options);
+        bool ok = connector(cmOUTPUT)->store(this, options);
+        if ( ok && OperationProfiler::active()) {
+            QUrl url = connector(cmOUTPUT)->source().url(true);
+            if ( url.isLocalFile())
+                OperationProfiler::count(OperationProfiler::cBYTESWRITTEN, QFileInfo(url.toLocalFile()).size());
+        }
+        return ok;
     }
 
     return ERROR1(ERR_NO_INITIALIZED_1,"connector");
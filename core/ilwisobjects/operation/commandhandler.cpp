@@ -42,6 +42,11 @@ ExecutionContext::ExecutionContext(bool threaded) {
     _threaded = threaded;
 }
 
+QString ExecutionContext::profileReport(const QString &format) const
+{
+    return OperationProfiler::report(_profiles, format);
+}
+
 void ExecutionContext::setOutput(SymbolTable &tbl, const QVariant &var, const QString &nme, quint64 tp, const Resource& resource, const QString& addInfo)
 {
     QString name =  nme == sUNDEF ? SymbolTable::newAnonym() : nme;
@@ -88,37 +93,63 @@ CommandHandler::~CommandHandler(){
 }
 
 bool CommandHandler::execute(const QString& command, ExecutionContext *ctx) {
-    if ( command == "") // ignore empty commands
-        return true;
-
     SymbolTable tbl;
-    OperationExpression expr(command, tbl);
-    quint64 id = findOperationId(expr);
-    if ( id != i64UNDEF) {
-        QScopedPointer<OperationImplementation> oper(create( expr));
-        if ( !oper.isNull() && oper->isValid()) {
-            return oper->execute(ctx, tbl);
-        }
-    }
-    return false;
+    return execute(command, ctx, tbl);
 }
 
 bool CommandHandler::execute(const QString &command, ExecutionContext *ctx, SymbolTable &symTable)
 {
     if ( command == "") // ignore empty commands
         return true;
+    if ( ctx && ctx->_profile)
+        return executeProfiled(command, ctx, symTable);
 
     OperationExpression expr(command, symTable);
     quint64 id = findOperationId(expr);
     if ( id != i64UNDEF) {
         QScopedPointer<OperationImplementation> oper(create( expr));
         if ( !oper.isNull() && oper->isValid()) {
-            return oper->execute(ctx, symTable);
+            bool ok = oper->execute(ctx, symTable);
+            oper->trq().flush();
+            return ok;
         }
     }
     return false;
 }
 
+bool CommandHandler::executeProfiled(const QString &command, ExecutionContext *ctx, SymbolTable &symTable)
+{
+    OperationProfiler profiler(command);
+    bool ok = false;
+    quint64 items = 0;
+    try {
+        OperationExpression expr(command, symTable);
+        QScopedPointer<OperationImplementation> oper;
+        if ( findOperationId(expr) != i64UNDEF)
+            oper.reset(create( expr));
+        if ( !oper.isNull() && oper->isValid()) {
+            profiler.dispatched(oper->metadata()->name());
+            // prepare is done here so that it can be timed; the operation will skip it in its execute
+            if ( oper->_prepState == OperationImplementation::sNOTPREPARED)
+                oper->_prepState = oper->prepare(ctx, symTable);
+            profiler.prepared();
+            if ( oper->_prepState == OperationImplementation::sPREPARED)
+                ok = oper->execute(ctx, symTable);
+            oper->trq().flush();
+            items = oper->trq().current();
+        } else
+            profiler.dispatched(expr.name());
+    } catch(...) {
+        profiler.executed(false, items);
+        ctx->_profiles.push_back(profiler.profile());
+        throw;
+    }
+    profiler.executed(ok, items);
+    ctx->_profiles.push_back(profiler.profile());
+
+    return ok;
+}
+
 OperationImplementation *CommandHandler::create(const OperationExpression &expr)  {
     auto docommand = [&](const OperationExpression &expression)->OperationImplementation *{
         quint64 id = findOperationId(expression);
@@ -146,63 +177,86 @@ void CommandHandler::addOperation(quint64 id, CreateOperation op)
     }
 }
 
+void CommandHandler::addOperationMetadata(const Resource &resource)
+{
+    OperationSignature signature;
+    signature._id = resource.id();
+    signature._inParameters = resource["inparameters"].toString();
+    QString key;
+    for(int n = 1; resource.hasProperty(key = QString("pin_%1_type").arg(n)); ++n)
+        signature._inTypes.push_back(resource[key].toULongLong());
+
+    Locker<std::mutex> lock(_metadataLock);
+    signature._sequence = _metadataSequence++;
+    _metadata[resource.url().toString().toLower()].push_back(signature);
+}
+
+void CommandHandler::removeOperationMetadata(quint64 id)
+{
+    Locker<std::mutex> lock(_metadataLock);
+    for(auto iter = _metadata.begin(); iter != _metadata.end(); ++iter) {
+        auto& signatures = (*iter).second;
+        auto found = std::find_if(signatures.begin(), signatures.end(), [id](const OperationSignature& sig){ return sig._id == id;});
+        if ( found != signatures.end()) {
+            signatures.erase(found);
+            if ( signatures.empty())
+                _metadata.erase(iter);
+            return;
+        }
+    }
+}
+
 quint64 CommandHandler::findOperationId(const OperationExpression& expr) const {
 
-    QSqlQuery db(kernel()->database());
-    QSqlQuery db2(kernel()->database());
-    QString query = QString("select * from mastercatalog where resource like '%1%' ").arg(expr.metaUrl().toString());
-    if (db.exec(query)) {
-        while ( db.next()){
-            quint64 itemid = db.value("itemid").toLongLong();
-            query = QString("select * from catalogitemproperties where itemid=%1").arg(itemid);
-            if (db2.exec(query)) {
-                std::map<QString, QString> values;
-                while ( db2.next()){
-                    QSqlRecord rec = db2.record();
-                    values[rec.value("propertyname").toString()] = rec.value("propertyvalue").toString();
-                }
-                QString parmcount = values["inparameters"];
-                if ( !expr.matchesParameterCount(parmcount))
+    // all resources whose url starts with the meta url of the expression, in registration order
+    QString prefix = expr.metaUrl().toString().toLower();
+    std::vector<const OperationSignature *> candidates;
+    Locker<std::mutex> lock(_metadataLock);
+    for(auto iter = _metadata.lower_bound(prefix); iter != _metadata.end() && (*iter).first.startsWith(prefix); ++iter) {
+        for(const OperationSignature& sig : (*iter).second)
+            candidates.push_back(&sig);
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const OperationSignature *sig1, const OperationSignature *sig2){ return sig1->_sequence < sig2->_sequence;});
+
+    for(const OperationSignature *sig : candidates) {
+        QString parmcount = sig->_inParameters;
+        if ( !expr.matchesParameterCount(parmcount))
+            continue;
+        bool found = true;
+        long index;
+        if ( (index = parmcount.indexOf('+')) != -1) {
+            index = parmcount.left(index).toUInt();
+        } else
+            index = 10000;
+        for(long i=0; i < expr.parameterCount(); ++i) {
+            int n = min(i+1, index);
+            if ( n > (long)sig->_inTypes.size()){
+                found = false;
+                break;
+            }
+            IlwisTypes tpExpr = expr.parm(i).valuetype();
+            IlwisTypes tpMeta = sig->_inTypes[n - 1];
+            if ( tpMeta != itSTRING) { // string matches with all
+                if ( hasType(tpMeta, itDOUBLE) && hasType(tpExpr, itNUMBER))
                     continue;
-                bool found = true;
-                long index;
-                if ( (index = parmcount.indexOf('+')) != -1) {
-                    index = parmcount.left(index).toUInt();
-                } else
-                    index = 10000;
-                for(long i=0; i < expr.parameterCount(); ++i) {
-                    int n = min(i+1, index);
-                    QString key = QString("pin_%1_type").arg(n);
-                    IlwisTypes tpExpr = expr.parm(i).valuetype();
-                    auto iter = values.find(key);
-                    if ( iter == values.end()){
-                        found = false;
-                        break;
-                    }
-                    IlwisTypes tpMeta = (*iter).second.toULongLong();
-                    if ( tpMeta != itSTRING) { // string matches with all
-                        if ( hasType(tpMeta, itDOUBLE) && hasType(tpExpr, itNUMBER))
+                if ( (tpMeta & tpExpr) == 0 && tpExpr != i64UNDEF) {
+                    if ( tpExpr == itSTRING){
+                        if (expr.parm(i).value() == ""){ // empty parameters are seen as strings and are acceptable. at operation level it should be decided what to do with it
+                            continue;
+                        }else if ( expr.parm(i).pathType() == Parameter::ptREMOTE){
+                            // we can't know what this parameter type realy is, so we accept it as valid
+                            // if it is incorrect the prepare of the operation will fail so no harm done
                             continue;
-                        if ( (tpMeta & tpExpr) == 0 && tpExpr != i64UNDEF) {
-                            if ( tpExpr == itSTRING){
-                                if (expr.parm(i).value() == ""){ // empty parameters are seen as strings and are acceptable. at operation level it should be decided what to do with it
-                                    continue;
-                                }else if ( expr.parm(i).pathType() == Parameter::ptREMOTE){
-                                    // we can't know what this parameter type realy is, so we accept it as valid
-                                    // if it is incorrect the prepare of the operation will fail so no harm done
-                                    continue;
-                                }
-                            }
-                            found = false;
-                            break;
                         }
                     }
-
+                    found = false;
+                    break;
                 }
-                if ( found)
-                    return itemid;
             }
+
         }
+        if ( found)
+            return sig->_id;
     }
     ERROR2(ERR_NO_INITIALIZED_2,"metadata",expr.name());
     return i64UNDEF;
@@ -5,9 +5,11 @@
 #include <QVector>
 #include <QVariant>
 #include <map>
+#include <mutex>
 #include "kernel_global.h"
 #include "ilwis.h"
 #include "symboltable.h"
+#include "operationprofiler.h"
 
 namespace Ilwis {
 
@@ -29,6 +31,10 @@ struct KERNELSHARED_EXPORT ExecutionContext {
     QString _masterGeoref;
     QString _masterCsy;
     std::ostream *_out;
+    // when set every command executed by the commandhandler is measured and added to _profiles; clear() leaves both untouched
+    bool _profile = false;
+    std::vector<OperationProfile> _profiles;
+    QString profileReport(const QString& format="json") const;
     void setOutput(SymbolTable &tbl, const QVariant &var, const QString &nme, quint64 tp, const Ilwis::Resource &resource, const QString &addInfo=sUNDEF);
     void addOutput(SymbolTable &tbl, const QVariant &var, const QString &nme, quint64 tp, const Resource &resource, const QString &addInfo=sUNDEF);
 
@@ -48,9 +54,28 @@ public:
     void addOperation(quint64 id, CreateOperation op);
     OperationImplementation *create(const Ilwis::OperationExpression &expr);
     quint64 findOperationId(const OperationExpression &expr) const;
+    /*!
+     addOperationMetadata registers the signature of an operation resource so that findOperationId can match expressions without querying the database.
+     The mastercatalog calls this for every operation resource it stores.
+     * \param resource resource of type itOPERATIONMETADATA
+     */
+    void addOperationMetadata(const Resource& resource);
+    void removeOperationMetadata(quint64 id);
 
 private:
+    bool executeProfiled(const QString &command, ExecutionContext *ctx, SymbolTable& symTable);
+
+    struct OperationSignature {
+        quint64 _id;
+        quint64 _sequence;
+        QString _inParameters;
+        std::vector<IlwisTypes> _inTypes; // pin_1_type at index 0
+    };
+
     std::map<quint64, CreateOperation> _commands;
+    std::map<QString, std::vector<OperationSignature>> _metadata; // key is the lower case resource url
+    quint64 _metadataSequence = 0;
+    mutable std::mutex _metadataLock;
     static CommandHandler *_commandHandler;
 
 
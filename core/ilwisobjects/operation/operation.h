@@ -10,6 +10,7 @@ class SymbolTable;
 
 class KERNELSHARED_EXPORT OperationImplementation : public Identity
 {
+    friend class CommandHandler;
 public:
     enum State{sNOTPREPARED,sPREPARED, sPREPAREFAILED};
     OperationImplementation() : _prepState(sNOTPREPARED) {}
@@ -21,7 +22,7 @@ public:
     virtual bool isValid() const;
     OperationExpression expression() const;
     void updateTranquilizer(quint64 currentCount, quint32 step){
-        if ( currentCount % step){
+        if ( currentCount % step == 0){
             trq().update(step);
         }
     }
@@ -0,0 +1,101 @@
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QStringList>
+#include "kernel.h"
+#include "operationprofiler.h"
+
+using namespace Ilwis;
+
+std::atomic<qint32> OperationProfiler::_active(0);
+std::atomic<quint64> OperationProfiler::_counters[OperationProfiler::cCOUNT];
+
+OperationProfiler::OperationProfiler(const QString &expression)
+{
+    _profile._expression = expression;
+    ++_active;
+    for(int i = 0; i < cCOUNT; ++i)
+        _start[i] = _counters[i].load();
+    _cpuStart = std::clock();
+    _timer.start();
+}
+
+OperationProfiler::~OperationProfiler()
+{
+    --_active;
+}
+
+qint64 OperationProfiler::elapsed()
+{
+    qint64 now = _timer.nsecsElapsed() / 1000;
+    qint64 duration = now - _mark;
+    _mark = now;
+    return duration;
+}
+
+void OperationProfiler::dispatched(const QString &operationName)
+{
+    _profile._operation = operationName;
+    _profile._dispatchTime = elapsed();
+}
+
+void OperationProfiler::prepared()
+{
+    _profile._prepareTime = elapsed();
+}
+
+void OperationProfiler::executed(bool succeeded, quint64 itemsProcessed)
+{
+    _profile._executeTime = elapsed();
+    _profile._cpuTime = (qint64)((std::clock() - _cpuStart) * 1000000.0 / CLOCKS_PER_SEC);
+    _profile._succeeded = succeeded;
+    _profile._itemsProcessed = itemsProcessed;
+    _profile._bytesRead = _counters[cBYTESREAD].load() - _start[cBYTESREAD];
+    _profile._bytesWritten = _counters[cBYTESWRITTEN].load() - _start[cBYTESWRITTEN];
+    _profile._cacheHits = _counters[cCACHEHITS].load() - _start[cCACHEHITS];
+    _profile._cacheMisses = _counters[cCACHEMISSES].load() - _start[cCACHEMISSES];
+    _profile._swaps = _counters[cSWAPS].load() - _start[cSWAPS];
+}
+
+const OperationProfile &OperationProfiler::profile() const
+{
+    return _profile;
+}
+
+QString OperationProfiler::report(const std::vector<OperationProfile> &profiles, const QString &format)
+{
+    if ( format.toLower() == "json") {
+        QJsonArray entries;
+        for(const OperationProfile& profile : profiles) {
+            QJsonObject entry;
+            entry["operation"] = profile._operation;
+            entry["expression"] = profile._expression;
+            entry["succeeded"] = profile._succeeded;
+            entry["dispatch_us"] = (double)profile._dispatchTime;
+            entry["prepare_us"] = (double)profile._prepareTime;
+            entry["execute_us"] = (double)profile._executeTime;
+            entry["cpu_us"] = (double)profile._cpuTime;
+            entry["items"] = (double)profile._itemsProcessed;
+            entry["bytes_read"] = (double)profile._bytesRead;
+            entry["bytes_written"] = (double)profile._bytesWritten;
+            entry["cache_hits"] = (double)profile._cacheHits;
+            entry["cache_misses"] = (double)profile._cacheMisses;
+            entry["swaps"] = (double)profile._swaps;
+            entries.append(entry);
+        }
+        return QString::fromUtf8(QJsonDocument(entries).toJson());
+    }
+    if ( format.toLower() == "csv") {
+        QStringList lines;
+        lines << "operation,expression,succeeded,dispatch_us,prepare_us,execute_us,cpu_us,items,bytes_read,bytes_written,cache_hits,cache_misses,swaps";
+        for(const OperationProfile& profile : profiles) {
+            QString expression = profile._expression;
+            expression.replace("\"","\"\"");
+            lines << QString("%1,\"%2\",%3,%4,%5,%6,%7,%8,%9,%10,%11,%12,%13").arg(profile._operation).arg(expression).arg(profile._succeeded ? "true" : "false").
+                     arg(profile._dispatchTime).arg(profile._prepareTime).arg(profile._executeTime).arg(profile._cpuTime).arg(profile._itemsProcessed).
+                     arg(profile._bytesRead).arg(profile._bytesWritten).arg(profile._cacheHits).arg(profile._cacheMisses).arg(profile._swaps);
+        }
+        return lines.join("\n") + "\n";
+    }
+    return "";
+}
@@ -0,0 +1,84 @@
+#ifndef OPERATIONPROFILER_H
+#define OPERATIONPROFILER_H
+
+#include <QString>
+#include <QElapsedTimer>
+#include <atomic>
+#include <vector>
+#include <ctime>
+#include "kernel_global.h"
+
+namespace Ilwis {
+
+/*!
+ * \brief The OperationProfile struct holds the measurements of one operation invocation
+ *
+ * All times are in microseconds. The counters are the differences of the process wide counters of the OperationProfiler between the start
+ * and the end of the invocation; operations that run at the same time will therefore see each others io and cache activity.
+ */
+struct KERNELSHARED_EXPORT OperationProfile {
+    QString _operation;
+    QString _expression;
+    bool _succeeded = false;
+    qint64 _dispatchTime = 0; // parsing of the expression, finding and creating the implementation
+    qint64 _prepareTime = 0;
+    qint64 _executeTime = 0;
+    qint64 _cpuTime = 0; // process cpu time consumed during prepare and execute
+    quint64 _itemsProcessed = 0; // pixels/features as reported to the tranquilizer of the operation
+    quint64 _bytesRead = 0;
+    quint64 _bytesWritten = 0;
+    quint64 _cacheHits = 0;
+    quint64 _cacheMisses = 0;
+    quint64 _swaps = 0;
+};
+
+/*!
+ * \brief The OperationProfiler class measures a single operation invocation
+ *
+ * The commandhandler creates a profiler for every command it executes when profiling is switched on in the ExecutionContext.
+ * Code that reads or writes data or manages caches reports its activity through count(); this costs one relaxed atomic load
+ * as long as no profiler is active.
+ */
+class KERNELSHARED_EXPORT OperationProfiler
+{
+public:
+    enum Counter{cBYTESREAD, cBYTESWRITTEN, cCACHEHITS, cCACHEMISSES, cSWAPS, cCOUNT};
+
+    OperationProfiler(const QString& expression);
+    ~OperationProfiler();
+
+    void dispatched(const QString& operationName);
+    void prepared();
+    void executed(bool succeeded, quint64 itemsProcessed);
+    const OperationProfile& profile() const;
+
+    static bool active() {
+        return _active.load(std::memory_order_relaxed) > 0;
+    }
+    static void count(Counter counter, quint64 amount=1) {
+        if ( active())
+            _counters[counter].fetch_add(amount, std::memory_order_relaxed);
+    }
+    /*!
+     * \brief report creates a structured report of a number of profiles
+     * \param profiles the profiles to report
+     * \param format either "json" or "csv"
+     * \return the report, or an empty string for an unknown format
+     */
+    static QString report(const std::vector<OperationProfile>& profiles, const QString& format="json");
+
+private:
+    qint64 elapsed();
+
+    OperationProfile _profile;
+    QElapsedTimer _timer;
+    qint64 _mark = 0;
+    std::clock_t _cpuStart;
+    quint64 _start[cCOUNT];
+
+    static std::atomic<qint32> _active;
+    static std::atomic<quint64> _counters[cCOUNT];
+};
+}
+
+#endif // OPERATIONPROFILER_H
@@ -13,23 +13,100 @@
 
 using namespace Ilwis;
 
-quint64 SymbolTable::_symbolid = 0;
+std::atomic<quint64> SymbolTable::_symbolid(0);
 
 SymbolTable::SymbolTable() //:
     //QHash<QString, Symbol>()
 {
 }
 
+SymbolTable::SymbolTable(const SymbolTable &table)
+{
+    auto lock = table.guard();
+    _slots = table._slots;
+    _names = table._names;
+    _freeSlots = table._freeSlots;
+    _index = table._index;
+}
+
+SymbolTable &SymbolTable::operator=(const SymbolTable &table)
+{
+    if ( this != &table) {
+        SymbolTable copy(table);
+        auto lock = guard();
+        _slots.swap(copy._slots);
+        _names.swap(copy._names);
+        _freeSlots.swap(copy._freeSlots);
+        _index.swap(copy._index);
+    }
+    return *this;
+}
+
 SymbolTable::~SymbolTable(){
-    _symbols.clear();
+    _index.clear();
+}
+
+qint32 SymbolTable::find(const QString &name) const
+{
+    auto iter = _index.find(name);
+    if ( iter == _index.end())
+        return -1;
+    return iter.value();
+}
+
+qint32 SymbolTable::insert(const QString &name, const Symbol &sym)
+{
+    qint32 slot;
+    if ( _freeSlots.size() > 0) {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        _slots[slot] = sym;
+        _names[slot] = name;
+    } else {
+        slot = _slots.size();
+        _slots.push_back(sym);
+        _names.push_back(name);
+    }
+    _index[name] = slot;
+    return slot;
+}
+
+std::unique_lock<std::recursive_mutex> SymbolTable::guard() const
+{
+    if ( _concurrent)
+        return std::unique_lock<std::recursive_mutex>(_lock);
+    return std::unique_lock<std::recursive_mutex>();
+}
+
+void SymbolTable::concurrent(bool yesno)
+{
+    _concurrent = yesno;
+}
+
+bool SymbolTable::concurrent() const
+{
+    return _concurrent;
+}
+
+Symbol SymbolTable::erase(qint32 slot)
+{
+    Symbol sym = _slots[slot];
+    _index.remove(_names[slot]);
+    _slots[slot] = Symbol();
+    _names[slot] = QString();
+    _freeSlots.push_back(slot);
+    return sym;
 }
 
 void SymbolTable::addSymbol(const QString &name, int scope, quint64 tp, const QVariant& v)
 {
-    QVariant var = getValue(name,scope); // do we already have it?
-    if (var.isValid()){
-        _symbols[name]._var = v;
-        _symbols[name]._type = tp;
+    auto lock = guard();
+    qint32 slot = find(name);
+    if ( slot != -1 && _slots[slot]._scope == scope && _slots[slot]._var.isValid()){ // do we already have it?
+        Symbol& sym = _slots[slot];
+        sym._var = v;
+        sym._type = tp;
+        sym.unbox();
         return;
     }
     if ( tp == 0) {
@@ -47,7 +124,10 @@ void SymbolTable::addSymbol(const QString &name, int scope, quint64 tp, const QV
 
     }
     Symbol sym(scope, tp, v);
-    _symbols[name] = sym;
+    if ( slot != -1)
+        _slots[slot] = sym;
+    else
+        insert(name, sym);
 }
 
 QVariant SymbolTable::getValue(const QString &name, int scope) const
@@ -55,17 +135,15 @@ QVariant SymbolTable::getValue(const QString &name, int scope) const
     if ( name.isNull() || name.isEmpty())
         return QVariant();
 
-    QHash<QString, Symbol>::const_iterator   iter = _symbols.find(name);
-    while (iter != _symbols.end() && iter.key() == name) {
-        if ( iter.value()._scope == scope) {
-            QString tp = iter.value()._var.typeName();
-            if ( tp == "QVariantList"){
-                QVariantList lst = iter.value()._var.value<QVariantList>();
-                return lst[0];
-            }
-            return iter.value()._var;
+    auto lock = guard();
+    qint32 slot = find(name);
+    if ( slot != -1 && _slots[slot]._scope == scope) {
+        const QVariant& var = _slots[slot]._var;
+        if ( var.userType() == QMetaType::QVariantList){
+            QVariantList lst = var.value<QVariantList>();
+            return lst[0];
         }
-        ++iter;
+        return var;
     }
     return QVariant();
 }
@@ -75,35 +153,55 @@ Symbol SymbolTable::getSymbol(const QString &name, GetAction act, int scope)
     if ( name.isNull() || name.isEmpty())
         return Symbol();
 
-    QHash<QString, Symbol>::iterator   iter = _symbols.find(name);
-    while (iter != _symbols.end() && iter.key() == name) {
-        if ( iter.value()._scope <= scope) {
-            Symbol sym = iter.value();
-            bool isAnonymous = name.indexOf(ANONYMOUS_PREFIX) == 0;
-            if ((isAnonymous && act == gaREMOVEIFANON) || act == gaREMOVE)
-                _symbols.erase(iter);
-            return sym;
-        }
-        ++iter;
+    Symbol sym;
+    {
+        auto lock = guard();
+        qint32 slot = find(name);
+        if ( slot == -1 || _slots[slot]._scope > scope)
+            return Symbol();
+        bool isAnonymous = name.indexOf(ANONYMOUS_PREFIX) == 0;
+        if ((isAnonymous && act == gaREMOVEIFANON) || act == gaREMOVE)
+            sym = erase(slot);
+        else
+            sym = _slots[slot];
     }
-    return Symbol();
+    return sym;
 }
 
 Symbol SymbolTable::getSymbol(const QString &name, int scope) const
 {
-    QHash<QString, Symbol>::const_iterator   iter = _symbols.find(name);
-    while (iter != _symbols.end() && iter.key() == name) {
-        if ( iter.value()._scope == scope) {
-            return iter.value();
-        }
-        ++iter;
-    }
+    auto lock = guard();
+    qint32 slot = find(name);
+    if ( slot != -1 && _slots[slot]._scope == scope)
+        return _slots[slot];
     return Symbol();
 }
 
+Symbol SymbolTable::getSymbol(const QString &name, qint32 &slot, int scope) const
+{
+    auto lock = guard();
+    if ( slot < 0 || slot >= (qint32)_names.size() || _names[slot] != name)
+        slot = find(name);
+    if ( slot != -1 && _slots[slot]._scope <= scope)
+        return _slots[slot];
+    return Symbol();
+}
+
+bool SymbolTable::getNumber(const QString &name, qint32 &slot, double &number, int scope) const
+{
+    auto lock = guard();
+    if ( slot < 0 || slot >= (qint32)_names.size() || _names[slot] != name)
+        slot = find(name);
+    if ( slot == -1 || _slots[slot]._scope > scope || !_slots[slot].isNumber())
+        return false;
+    number = _slots[slot]._number;
+    return true;
+}
+
 void SymbolTable::unloadRasters()
 {
-    for(Symbol& sym: _symbols) {
+    auto lock = guard();
+    for(const Symbol& sym: _slots) {
         if ( sym._type == itRASTER) {
             IRasterCoverage raster = sym._var.value<IRasterCoverage>();
             if ( raster.isValid())
@@ -118,9 +216,12 @@ IlwisTypes SymbolTable::ilwisType(const QVariant &value, const QString& symname)
         return Domain::ilwType(value);
     }
 
-    auto iter = _symbols.find(symname);
-    if ( iter != _symbols.end()) {
-        return iter.value()._type;
+    {
+        auto lock = guard();
+        qint32 slot = find(symname);
+        if ( slot != -1) {
+            return _slots[slot]._type;
+        }
     }
 
     IlwisTypes tp = IlwisObject::findType(symname);
@@ -152,6 +253,21 @@ bool SymbolTable::isRealNumerical(const QVariant& var)  {
     return ok;
 }
 
+bool SymbolTable::asNumber(const QVariant &var, double &number)
+{
+    switch(var.userType()) {
+    case QMetaType::Double: case QMetaType::Float:
+    case QMetaType::Int: case QMetaType::UInt:
+    case QMetaType::LongLong: case QMetaType::ULongLong:
+    case QMetaType::Long: case QMetaType::ULong:
+    case QMetaType::Short: case QMetaType::UShort:
+        number = var.toDouble();
+        return true;
+    default:
+        return false;
+    }
+}
+
 bool SymbolTable::isIndex(int index, const QVariantList& var) {
   QString tpname = var[index].typeName();
   if ( tpname == "std::vector<quint32>" || tpname == "Indices")
@@ -195,15 +311,52 @@ bool SymbolTable::isDataLink(const QVariant& value) {
 
 }
 
+void SymbolTable::releaseAnonymous(const QString &name)
+{
+    if ( name.indexOf(ANONYMOUS_PREFIX) != 0)
+        return;
+    Symbol sym; // the object is released outside the lock, its destruction may reach the mastercatalog
+    {
+        auto lock = guard();
+        qint32 slot = find(name);
+        if ( slot == -1)
+            return;
+        sym = erase(slot);
+    }
+}
+
+void SymbolTable::releaseAnonymous(quint64 createdAfter, const std::vector<QString> &keep)
+{
+    const int prefixSize = QString(ANONYMOUS_PREFIX).size();
+    std::vector<Symbol> released;
+    {
+        auto lock = guard();
+        for(qint32 slot = 0; slot < (qint32)_names.size(); ++slot) {
+            const QString& name = _names[slot];
+            bool ok;
+            if ( name.indexOf(ANONYMOUS_PREFIX) == 0 && name.mid(prefixSize).toULongLong(&ok) > createdAfter && ok &&
+                 std::find(keep.begin(), keep.end(), name) == keep.end()) {
+                released.push_back(erase(slot));
+            }
+        }
+    }
+}
+
+quint64 SymbolTable::anonymCount()
+{
+    return _symbolid;
+}
+
 QString SymbolTable::newAnonym()
 {
-    _symbolid++;
-    return QString("%1%2").arg(ANONYMOUS_PREFIX).arg(_symbolid);
+    quint64 id = ++_symbolid;
+    return QString("%1%2").arg(ANONYMOUS_PREFIX).arg(id);
 }
 
 
 Symbol::Symbol(int scope, quint64 tp, const QVariant &v) : _type(tp), _scope(scope), _var(v)
 {
+    unbox();
 }
 
 Symbol::~Symbol()
@@ -216,4 +369,15 @@ bool Symbol::isValid() const
     return _var.isValid() && _scope != iUNDEF;
 }
 
+bool Symbol::isNumber() const
+{
+    return _isNumber;
+}
 
+void Symbol::unbox()
+{
+    // only values that already are numbers; strings that happen to parse as a number stay strings
+    _isNumber = SymbolTable::asNumber(_var, _number);
+    if ( !_isNumber)
+        _number = rUNDEF;
+}
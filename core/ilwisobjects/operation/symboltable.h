@@ -4,6 +4,8 @@
 #include "kernel_global.h"
 #include <QVariant>
 #include <QMultiHash>
+#include <mutex>
+#include <atomic>
 
 namespace Ilwis {
 class KERNELSHARED_EXPORT Symbol{
@@ -15,6 +17,15 @@ public:
     QVariant _var;
     QVariant _modifier;
     bool isValid() const;
+    /*!
+     \brief true if the symbol holds a plain number; its value is then also available unboxed in _number
+     */
+    bool isNumber() const;
+    double _number;
+private:
+    friend class SymbolTable;
+    void unbox();
+    bool _isNumber;
 };
 
 class KERNELSHARED_EXPORT SymbolTable //: private QHash<QString, Symbol>
@@ -22,18 +33,54 @@ class KERNELSHARED_EXPORT SymbolTable //: private QHash<QString, Symbol>
 public:
     enum GetAction { gaKEEP, gaREMOVE, gaREMOVEIFANON};
     SymbolTable();
+    SymbolTable(const SymbolTable& table);
     virtual ~SymbolTable();
+    SymbolTable& operator=(const SymbolTable& table);
 
     void addSymbol(const QString& name, int scope, quint64 tp, const QVariant &v=QVariant());
     QVariant getValue(const QString& name, int scope=1000) const;
     Symbol getSymbol(const QString& name, GetAction act=gaKEEP, int scope=1000);
     Symbol getSymbol(const QString& name, int scope=1000) const;
+    /*!
+     \brief getSymbol with a slot hint
+
+     Symbols are kept in slots. Callers that look up the same name repeatedly (e.g. the nodes of a script) remember the slot
+     and pass it back; a valid hint avoids the name lookup. An invalid or outdated hint is corrected.
+     \param name name of the symbol
+     \param slot in: the remembered slot or -1, out: the slot of the symbol or -1 if it does not exist
+     \param scope the symbol's scope may not be larger than this
+     \return the symbol or an invalid symbol
+     */
+    Symbol getSymbol(const QString& name, qint32& slot, int scope=1000) const;
+    /*!
+     \brief getNumber with a slot hint, for symbols that hold a plain number
+
+     As getSymbol with a slot hint, but without copying the symbol; the unboxed value is returned directly
+     \param number receives the value of the symbol
+     \return true if the symbol exists and holds a plain number
+     */
+    bool getNumber(const QString& name, qint32& slot, double& number, int scope=1000) const;
     template<typename T> T getValue(const QString& name){
         QVariant var = getValue(name)    ;
         return var.value<T>();
     }
 
     void unloadRasters();
+    /*!
+     concurrent switches the locking of the table. A table is normally used by one thread and accessed without locks; while statements
+     of a script are evaluated concurrently on it, it must guard itself. Only switch it when no other thread uses the table.
+     */
+    void concurrent(bool yesno);
+    bool concurrent() const;
+    /*!
+     releaseAnonymous removes an anonymous (intermediate) symbol. The object it holds is freed as soon as nothing else references it.
+     Named symbols are never removed by this method.
+     */
+    void releaseAnonymous(const QString& name);
+    /*!
+     releaseAnonymous removes all anonymous symbols created after the given anonymous count (see anonymCount), except those in keep
+     */
+    void releaseAnonymous(quint64 createdAfter, const std::vector<QString>& keep);
     IlwisTypes ilwisType(const QVariant &value, const QString &symname) const;
 
     static bool isNumerical(const QVariant &var) ;
@@ -41,11 +88,27 @@ public:
     static bool isIntegerNumerical(const QVariant &var) ;
     static bool isDataLink(const QVariant &value);
     static QString newAnonym();
+    static quint64 anonymCount();
     static bool isString(const QVariant &var);
+    /*!
+     \brief asNumber true if the variant holds a number; strings that happen to parse as a number are no numbers here
+     */
+    static bool asNumber(const QVariant &var, double& number);
     static bool isIndex(int index, const QVariantList &var);
 private:
-    QHash<QString, Symbol> _symbols;
-    static quint64 _symbolid;
+    qint32 find(const QString& name) const;
+    qint32 insert(const QString& name, const Symbol& sym);
+    Symbol erase(qint32 slot);
+    std::unique_lock<std::recursive_mutex> guard() const;
+
+    std::vector<Symbol> _slots;
+    std::vector<QString> _names; // name of the symbol in each slot; empty for free slots
+    std::vector<qint32> _freeSlots;
+    QHash<QString, qint32> _index;
+    // only taken while the table is used concurrently, see concurrent()
+    mutable std::recursive_mutex _lock;
+    bool _concurrent = false;
+    static std::atomic<quint64> _symbolid;
 
     
     
@@ -10,6 +10,22 @@
 
 using namespace Ilwis;
 
+std::atomic<quint64> ColorLookUp::_lastVersion(0);
+
+ColorLookUp::ColorLookUp() : _version(++_lastVersion)
+{
+}
+
+quint64 ColorLookUp::version() const
+{
+    return _version;
+}
+
+void ColorLookUp::changed()
+{
+    _version = ++_lastVersion;
+}
+
 std::vector<QColor> ColorLookUp::values2colors(const std::vector<double> &values, const NumericRange &actualRange, const NumericRange &stretchRange) const
 {
     std::vector<QColor> colors(values.size());
@@ -1,6 +1,8 @@
 #ifndef COLORLOOKUP_H
 #define COLORLOOKUP_H
 
+#include <atomic>
+
 namespace Ilwis {
 
 class NumericRange;
@@ -8,11 +10,25 @@ class NumericRange;
 class KERNELSHARED_EXPORT ColorLookUp
 {
 public:
+    ColorLookUp();
+    virtual ~ColorLookUp() {}
     virtual QColor value2color(double value, const NumericRange& actualRange = NumericRange(), const NumericRange& stretchRange = NumericRange()) const = 0;
     std::vector<QColor> values2colors(const std::vector<double>& values, const NumericRange& actualRange = NumericRange(), const NumericRange& stretchRange = NumericRange()) const;
 
+    /*!
+     * \brief version identifies the state of the lookup; it changes with every modification and is never shared by two lookups, so a
+     * compiled form (see ColorTable) can be checked against it
+     */
+    quint64 version() const;
+
 protected:
     QColor string2color(const QString &colorstring);
+    void changed();
+
+private:
+    quint64 _version;
+
+    static std::atomic<quint64> _lastVersion;
 };
 
 
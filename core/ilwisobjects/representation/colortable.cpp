@@ -0,0 +1,59 @@
+#include "kernel.h"
+#include "ilwisdata.h"
+#include "range.h"
+#include "numericrange.h"
+#include "colorlookup.h"
+#include "colortable.h"
+
+using namespace Ilwis;
+
+ColorTable::ColorTable() : _table(1, 0)
+{
+}
+
+ColorTable::ColorTable(const ColorLookUp &lookup, const NumericRange &actualRange, const NumericRange &stretchRange, quint32 indexCount)
+{
+    if ( indexCount != iUNDEF){
+        // raw values are mapped directly on the table
+        _table.resize(std::max(indexCount, 1U));
+        for(quint32 i = 0; i < _table.size(); ++i)
+            _table[i] = lookup.value2color(i, actualRange, stretchRange).rgba();
+        _offset = 0;
+        _scale = 1;
+    } else {
+        _table.resize(CONTINUOUSSIZE);
+        if ( !actualRange.isValid() || actualRange.distance() <= 0){
+            std::fill(_table.begin(), _table.end(), lookup.value2color(actualRange.min(), actualRange, stretchRange).rgba());
+            _offset = actualRange.min();
+            _scale = 0;
+        } else {
+            double step = actualRange.distance() / (CONTINUOUSSIZE - 1);
+            for(quint32 i = 0; i < CONTINUOUSSIZE; ++i)
+                _table[i] = lookup.value2color(actualRange.min() + i * step, actualRange, stretchRange).rgba();
+            _offset = actualRange.min() - step / 2; // rounds to the nearest sample
+            _scale = 1.0 / step;
+        }
+    }
+    _maxIndex = _table.size() - 1;
+}
+
+bool ColorTable::isValid() const
+{
+    return _scale != 0 || _table.size() > 1;
+}
+
+quint32 ColorTable::size() const
+{
+    return _table.size();
+}
+
+QColor ColorTable::value2color(double value) const
+{
+    return QColor::fromRgba(value2rgba(value));
+}
+
+void ColorTable::values2rgba(const double *values, quint32 count, QRgb *colors) const
+{
+    for(quint32 i = 0; i < count; ++i)
+        colors[i] = value2rgba(values[i]);
+}
@@ -0,0 +1,57 @@
+#ifndef COLORTABLE_H
+#define COLORTABLE_H
+
+#include <cmath>
+#include <QColor>
+
+namespace Ilwis {
+
+class ColorLookUp;
+class NumericRange;
+
+/*!
+ * \brief The ColorTable class is a color lookup compiled for one actual and stretch range
+ *
+ * Continuous lookups are sampled into a dense table over the actual range; values outside the range get the color of the nearest end.
+ * Indexed lookups (palettes, item domains) get one entry per raw value. After compilation a value is mapped to a packed QRgb color with an
+ * undefined check, a multiplication, a clamp and one table access, so it can be applied to large arrays of values (features, raster blocks) without
+ * going through QVariant or QColor. A table is read only after construction and can be shared between threads.
+ */
+class KERNELSHARED_EXPORT ColorTable
+{
+public:
+    static const quint32 CONTINUOUSSIZE = 4096;
+
+    ColorTable();
+    /*!
+     * \brief ColorTable creates a table for a lookup
+     * \param lookup the lookup of a representation
+     * \param actualRange range of the values that will be mapped
+     * \param stretchRange stretch as used by the lookup, may be invalid
+     * \param indexCount number of raw values for indexed lookups, iUNDEF for continuous lookups
+     */
+    ColorTable(const ColorLookUp& lookup, const NumericRange& actualRange, const NumericRange& stretchRange, quint32 indexCount=iUNDEF);
+
+    bool isValid() const;
+    quint32 size() const;
+
+    QRgb value2rgba(double value) const{
+        // checked before the index is computed; NaN passes the clamp and can't be converted to an index
+        if ( std::isnan(value) || isNumericalUndef(value))
+            return _undefColor;
+        double position = std::min(std::max((value - _offset) * _scale, 0.0), _maxIndex);
+        return _table[(quint32)position];
+    }
+    QColor value2color(double value) const;
+    void values2rgba(const double *values, quint32 count, QRgb *colors) const;
+
+private:
+    std::vector<QRgb> _table;
+    double _offset = 0;
+    double _scale = 0;
+    double _maxIndex = 0;
+    QRgb _undefColor = 0;
+};
+}
+
+#endif // COLORTABLE_H
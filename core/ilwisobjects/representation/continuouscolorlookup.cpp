@@ -96,4 +96,5 @@ void ContinuousColorLookup::addGroup(const NumericRange &range, const Continuous
     }
     _colorranges.push_back(colorrange);
     _groups.push_back(range);
+    changed();
 }
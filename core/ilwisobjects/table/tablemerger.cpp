@@ -1,3 +1,5 @@
+#include <future>
+#include <QThread>
 #include "kernel.h"
 #include "ilwisdata.h"
 #include "domain.h"
@@ -142,38 +144,153 @@ ITable TableMerger::mergeMetadataTables(const ITable& tbl1, const ITable& tbl2)
     return newTable;
 }
 
-void TableMerger::mergeTableData(const ITable &sourceTable1,const ITable &sourceTable2, ITable &targetTable, const std::vector<QString>& except) const
+bool TableMerger::mergeTableData(const ITable &sourceTable1,const ITable &sourceTable2, ITable &targetTable, const std::vector<QString>& except, const QString &keyColumn) const
 {
+    quint32 records1 = sourceTable1->recordCount();
+    std::vector<quint32> records2; // target records of the records of the second table, empty when they are appended
+    quint32 records = records1 + sourceTable2->recordCount();
+    if ( keyColumn != sUNDEF){
+        records = joinRecords(sourceTable1, sourceTable2, keyColumn, records2);
+        if ( records == iUNDEF)
+            return false;
+    }
+
+    std::vector<MergeColumn> columns;
+    std::map<QString, quint32> columnIndex;
     for(int col=0; col < sourceTable1->columnCount(); ++col ) {
         const auto& coldef = sourceTable1->columndefinition(col);
         auto iter = std::find(except.begin(), except.end(), coldef.name());
         if ( iter != except.end())
             continue;
-        auto values = sourceTable1->column(coldef.name()) ;
-        targetTable->column(coldef.name(),values);
+        columnIndex[coldef.name()] = columns.size();
+        columns.push_back(MergeColumn());
+        columns.back()._name = coldef.name();
+        columns.back()._values1 = sourceTable1->column(coldef.name());
     }
     for(int col=0; col < sourceTable2->columnCount(); ++col ) {
         const auto& coldef = sourceTable2->columndefinition(col);
         auto iterex = std::find(except.begin(), except.end(), coldef.name());
         if ( iterex != except.end())
             continue;
-        auto values = sourceTable2->column(coldef.name()) ;
         QString targetColName = coldef.name();
         std::map<QString, QString>::const_iterator iter;
         if ( (iter = _columnRenames.find(targetColName)) != _columnRenames.end()) {
             targetColName = (*iter).second;
         }
+        auto iterIndex = columnIndex.find(targetColName);
+        if ( iterIndex == columnIndex.end()){
+            iterIndex = columnIndex.insert({targetColName, columns.size()}).first;
+            columns.push_back(MergeColumn());
+            columns.back()._name = targetColName;
+        }
+        MergeColumn& column = columns[(*iterIndex).second];
+        column._values2 = sourceTable2->column(coldef.name());
         std::map<QString, RenumberMap>::const_iterator iterR;
         if ( (iterR = _renumberers.find(targetColName)) != _renumberers.end()) {
-            const RenumberMap& renumberer = (*iterR).second;
-            for(auto pair : renumberer) {
-                for(auto& val : values) {
-                    if ( pair.first == val)
-                        val = pair.second;
-                }
-            }
+            column._renumberer = &(*iterR).second;
+        }
+    }
+
+    // renumbering and joining of a column doesn't depend on the other columns
+    int tasks = std::min(QThread::idealThreadCount(), (int)columns.size());
+    if ( (quint64)records * columns.size() < MINPARALLELVALUES || tasks < 2){
+        for(MergeColumn& column : columns)
+            prepareColumn(column, records2, records);
+    } else {
+        std::vector<std::future<void>> futures;
+        for(int task = 0; task < tasks; ++task){
+            futures.push_back(std::async(std::launch::async, [&](int first){
+                for(quint32 col = first; col < columns.size(); col += tasks)
+                    prepareColumn(columns[col], records2, records);
+            }, task));
+        }
+        for(auto& future : futures)
+            future.get();
+    }
+
+    // the target table isn't thread safe, so the columns are written one by one
+    for(const MergeColumn& column : columns){
+        if ( column._values1.size() > 0)
+            targetTable->column(column._name, column._values1);
+        if ( column._values2.size() > 0)
+            targetTable->column(column._name, column._values2, records1);
+    }
+    return true;
+}
+
+quint32 TableMerger::joinRecords(const ITable &sourceTable1, const ITable &sourceTable2, const QString &keyColumn, std::vector<quint32> &records2) const
+{
+    if ( !sourceTable1->columndefinition(keyColumn).isValid()){
+        ERROR2(ERR_NOT_FOUND2, keyColumn, sourceTable1->name());
+        return iUNDEF;
+    }
+    if ( !sourceTable2->columndefinition(keyColumn).isValid()){
+        ERROR2(ERR_NOT_FOUND2, keyColumn, sourceTable2->name());
+        return iUNDEF;
+    }
+    std::vector<QVariant> keys1 = sourceTable1->column(keyColumn);
+    std::vector<QVariant> keys2 = sourceTable2->column(keyColumn);
+    // the keys of the second table must be compared in the numbering of the first table
+    auto iterR = _renumberers.find(keyColumn);
+    if ( iterR != _renumberers.end())
+        renumber(keys2, (*iterR).second);
+
+    QHash<QString, quint32> index;
+    index.reserve(keys1.size());
+    for(quint32 rec = 0; rec < keys1.size(); ++rec){
+        QString key = keys1[rec].toString();
+        if ( !index.contains(key)) // with duplicate keys the first record is used
+            index.insert(key, rec);
+    }
+    quint32 records = keys1.size();
+    records2.resize(keys2.size());
+    for(quint32 rec = 0; rec < keys2.size(); ++rec){
+        auto iter = index.find(keys2[rec].toString());
+        records2[rec] = iter != index.end() ? iter.value() : records++;
+    }
+    return records;
+}
+
+void TableMerger::prepareColumn(MergeColumn &column, const std::vector<quint32>& records2, quint32 records) const
+{
+    if ( column._renumberer)
+        renumber(column._values2, *column._renumberer);
+    if ( records2.size() == 0)
+        return;
+    // joined; all values are placed in one column that is written from the first record
+    column._values1.resize(records);
+    for(quint32 rec = 0; rec < column._values2.size(); ++rec)
+        column._values1[records2[rec]] = column._values2[rec];
+    column._values2 = std::vector<QVariant>();
+}
+
+void TableMerger::renumber(std::vector<QVariant> &values, const RenumberMap &renumberer)
+{
+    if ( renumberer.size() == 0)
+        return;
+
+    quint64 maxRaw = (*renumberer.rbegin()).first;
+    std::vector<quint64> direct;
+    if ( maxRaw < MAXDIRECTRENUMBER){
+        direct.resize(maxRaw + 1);
+        for(quint64 raw = 0; raw <= maxRaw; ++raw)
+            direct[raw] = raw;
+        for(const auto& pair : renumberer)
+            direct[pair.first] = pair.second;
+    }
+    for(QVariant& val : values) {
+        bool ok;
+        quint64 raw = val.toULongLong(&ok);
+        if ( !ok)
+            continue;
+        if ( direct.size() > 0) {
+            if ( raw <= maxRaw && direct[raw] != raw)
+                val = direct[raw];
+        } else {
+            auto iter = renumberer.find(raw);
+            if ( iter != renumberer.end())
+                val = (*iter).second;
         }
-        targetTable->column(targetColName,values, sourceTable1->recordCount());
     }
 }
 
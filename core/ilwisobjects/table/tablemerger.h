@@ -8,12 +8,42 @@ public:
     TableMerger();
     ITable mergeMetadataTables(const ITable &tbl1, const ITable &tbl2);
     bool mergeMetadataTables(ITable &tblOut, const ITable &tblIn, const std::vector<QString> &columns);
-    void mergeTableData(const ITable &sourceTable1,const ITable &sourceTable2, ITable &targetTable, const std::vector<QString>& except=std::vector<QString>()) const;
+    /*!
+     * \brief mergeTableData fills the target table with the records of two tables
+     *
+     * Without a key column the records of the second table are appended to those of the first table. With a key column the records of the second table
+     * are joined to the records of the first table that have the same key (through a hash index on the keys of the first table); records with a key
+     * that doesn't occur in the first table are appended. In joined records the values of the second table replace those of the first table.
+     * Item values of the second table are renumbered with the renumber maps made while merging the metadata. The columns are prepared in parallel.
+     * \param except columns that are not copied
+     * \param keyColumn name of the key column in both tables, sUNDEF to append the records
+     * \return false if the key column doesn't exist in one of the tables
+     */
+    bool mergeTableData(const ITable &sourceTable1,const ITable &sourceTable2, ITable &targetTable, const std::vector<QString>& except=std::vector<QString>(), const QString& keyColumn=sUNDEF) const;
     bool copyColumns(const ITable &tblSource, ITable &tbltarget, int options=0);
+
+    /*!
+     * \brief renumber replaces the raw values of items in a column according to a renumber map
+     *
+     * Dense raws are renumbered through a direct raw to raw array, others through the map. Values that are not in the map are left as they are.
+     */
+    static void renumber(std::vector<QVariant>& values, const RenumberMap& renumberer);
 private:
+    struct MergeColumn {
+        QString _name;
+        std::vector<QVariant> _values1;
+        std::vector<QVariant> _values2;
+        const RenumberMap *_renumberer = 0;
+    };
+
+    static const quint64 MAXDIRECTRENUMBER = 1 << 20;
+    static const quint64 MINPARALLELVALUES = 100000;
+
     std::map<QString, RenumberMap> _renumberers;
     std::map<QString, QString> _columnRenames;
     ColumnDefinition mergeColumnDefinitions(const Ilwis::ColumnDefinition &def1, const Ilwis::ColumnDefinition &def2, RenumberMap* renum=0);
+    quint32 joinRecords(const ITable &sourceTable1, const ITable &sourceTable2, const QString& keyColumn, std::vector<quint32>& records2) const;
+    void prepareColumn(MergeColumn& column, const std::vector<quint32> &records2, quint32 records) const;
 };
 }
 
@@ -5,6 +5,7 @@
 #include <QDataStream>
 #include <QUrl>
 #include <fstream>
+#include <sstream>
 #include <iomanip>
 #include "kernel.h"
 #include "ilwisdata.h"
@@ -15,6 +16,7 @@
 using namespace Ilwis;
 
 std::map<std::thread::id, bool> IssueLogger::_silentThreads;
+std::mutex IssueLogger::_silentMutex;
 
 IssueObject::IssueObject(QObject* parent) : QObject(parent)
 {
@@ -90,7 +92,7 @@ void IssueObject::addCodeInfo(int line, const QString &func, const QString &file
     _file = file;
 }
 
-void IssueObject::stream(std::ofstream& stream, LogMessageFormat frmt) {
+void IssueObject::stream(std::ostream& stream, LogMessageFormat frmt) {
     stream << std::setw(4) << _id << " ; " << std::setw(9) << type2String().toStdString() << " ; " << std::setw(27)<<_itime.toString().toStdString() << " ; " << _message.toStdString() << std::endl;
     if ( frmt == lmCODE) {
         stream << std::setw(4) << _id << " ; " << _line << " : " << _func.toStdString() << " ; " << _file.toStdString() << std::endl;
@@ -123,6 +125,7 @@ QString IssueObject::type2String() const{
 //---------------------------------------------------------------------------
 IssueLogger::IssueLogger(QObject *parent) : QObject(parent), _repeatCount(0)
 {
+    std::fill(_typeCounts, _typeCounts + 8, 0);
     QString apploc= context()->ilwisFolder().absoluteFilePath();
     apploc += "/log";
     QDir dir(apploc);
@@ -132,55 +135,124 @@ IssueLogger::IssueLogger(QObject *parent) : QObject(parent), _repeatCount(0)
     QString clogFilePath = apploc + "/logfile_ext.txt";
     _logFileRegular.open(rlogFilePath.toLatin1());
     _logFileCode.open(clogFilePath.toLatin1());
+    _logThread = std::thread(&IssueLogger::logWriter, this);
 }
 
 IssueLogger::~IssueLogger()
 {
+    {
+        std::lock_guard<std::mutex> lock(_logMutex);
+        _stopLogging = true;
+    }
+    _logCondition.notify_one();
+    if ( _logThread.joinable())
+        _logThread.join();
+
     if (_logFileCode.is_open())
         _logFileCode.close();
     if ( _logFileRegular.is_open())
         _logFileRegular.close();
 }
 
+void IssueLogger::logWriter()
+{
+    std::deque<std::pair<IssueObject::LogMessageFormat, std::string>> lines;
+    while(true) {
+        {
+            std::unique_lock<std::mutex> lock(_logMutex);
+            _logCondition.wait(lock, [this]{ return _stopLogging || !_pendingLogs.empty();});
+            lines.swap(_pendingLogs);
+            if ( lines.empty() && _stopLogging)
+                return;
+        }
+        for(const auto& line : lines) {
+            std::ofstream& file = line.first == IssueObject::lmCODE ? _logFileCode : _logFileRegular;
+            if ( file.is_open())
+                file << line.second;
+        }
+        _logFileRegular.flush();
+        _logFileCode.flush();
+        lines.clear();
+    }
+}
+
+void IssueLogger::writeLog(const IssueObject& issue, IssueObject::LogMessageFormat frmt)
+{
+    std::ostringstream line;
+    const_cast<IssueObject&>(issue).stream(line, frmt);
+    {
+        std::lock_guard<std::mutex> lock(_logMutex);
+        _pendingLogs.push_back({frmt, line.str()});
+    }
+    _logCondition.notify_one();
+}
+
+void IssueLogger::enqueue(const IssueObject &issue)
+{
+    _issues.push_back(issue);
+    _issueIndex[issue.id()] = --_issues.end();
+    for(int bit = 0; bit < 8; ++bit)
+        if ( issue.type() & (1 << bit))
+            ++_typeCounts[bit];
+    if ( _issues.size() > MAXISSUES)
+        erase(_issues.begin());
+}
+
+IssueLogger::IssueList::iterator IssueLogger::erase(IssueList::iterator iter)
+{
+    auto index = _issueIndex.find((*iter).id());
+    if ( index != _issueIndex.end() && index.value() == iter)
+        _issueIndex.erase(index);
+    for(int bit = 0; bit < 8; ++bit)
+        if ( (*iter).type() & (1 << bit))
+            --_typeCounts[bit];
+    return _issues.erase(iter);
+}
+
 quint64 IssueLogger::log(const QString &message, int it)
 {
-    ++_repeatCount;
-    std::thread::id id = std::this_thread::get_id();
-    if ( _silentThreads.find(id)!= _silentThreads.end() && it != IssueObject::itCritical){
+    if ( silent() && it != IssueObject::itCritical){
+        std::lock_guard<std::mutex> lock(_issueMutex);
         _repeatCount = 0;
         return i64UNDEF;
     }
 
-
-    if ( _lastmessage == message && _repeatCount == 10) {
-        return _issueId;
-    } else {
-        // Mechanism to prevent(some) 'stuck in a loop' kind of errors.
-        // this should basically be solved at the place the loop is happening but oversights happen.
-        // This is a last fallback to break the loop without the need to stop the process
-        if ( _repeatCount > 10 && _lastmessage != message ){
-            _issues.enqueue(IssueObject(QString("Message repeated %1 times").arg(_repeatCount), it, _issueId));
+    quint64 issueid;
+    IssueObject obj;
+    {
+        std::lock_guard<std::mutex> lock(_issueMutex);
+        ++_repeatCount;
+        if ( _lastmessage == message && _repeatCount == 10) {
+            return _issueId;
+        } else {
+            // Mechanism to prevent(some) 'stuck in a loop' kind of errors.
+            // this should basically be solved at the place the loop is happening but oversights happen.
+            // This is a last fallback to break the loop without the need to stop the process
+            if ( _repeatCount > 10 && _lastmessage != message ){
+                enqueue(IssueObject(QString("Message repeated %1 times").arg(_repeatCount), it, _issueId));
+                _repeatCount = 0;
+                throw ErrorObject(QString("Error message cascade : %1").arg(message));
+            }
             _repeatCount = 0;
-            throw ErrorObject(QString("Error message cascade : %1").arg(message));
         }
-        _repeatCount = 0;
-    }
 
-    _issues.enqueue(IssueObject(message, it, _issueId));
-    if ( _lastmessage == message)
-        return _issueId;
-    IssueObject& obj = _issues.back();
-    if ( _logFileRegular.is_open()) {
-        obj.stream(_logFileRegular, IssueObject::lmREGULAR);
+        obj = IssueObject(message, it, _issueId);
+        enqueue(obj);
+        if ( _lastmessage == message)
+            return _issueId;
+        _lastmessage = message;
+        issueid = _issueId++;
     }
+
+    // file io, console output and notification happen outside the lock
+    writeLog(obj, IssueObject::lmREGULAR);
     if ( hasType(context()->runMode(),rmCOMMANDLINE)){
         if ( it == IssueObject::itError)
             std::cerr << message.toStdString() << "\n";
     }
     emit updateIssues(obj);
 
-    _lastmessage = message;
-    return _issueId++;
+    return issueid;
 }
 
 quint64 IssueLogger::log(const QString& objectName, const QString &message, int it)
@@ -191,21 +263,23 @@ quint64 IssueLogger::log(const QString& objectName, const QString &message, int
 
 void IssueLogger::addCodeInfo(quint64 issueid, int line, const QString &func, const QString &file)
 {
-    for(auto iter=_issues.begin(); iter != _issues.end(); ++iter) {
-        IssueObject& issue = *iter;
-        if ( issue.id() == issueid) {
-            issue.addCodeInfo(line, func, file);
-            if ( _logFileCode.is_open()) {
-                issue.stream(_logFileCode, IssueObject::lmCODE);
-            }
-            break;
-        }
+    IssueObject issue;
+    {
+        std::lock_guard<std::mutex> lock(_issueMutex);
+        auto iter = _issueIndex.find(issueid);
+        if ( iter == _issueIndex.end())
+            return;
+        IssueObject& stored = *iter.value();
+        stored.addCodeInfo(line, func, file);
+        issue = stored;
     }
+    writeLog(issue, IssueObject::lmCODE);
 }
 
 bool IssueLogger::silent() const
 {
     std::thread::id id = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(_silentMutex);
     auto iter = _silentThreads.find(id);
     if ( iter != _silentThreads.end())
         return iter->second;
@@ -215,6 +289,7 @@ bool IssueLogger::silent() const
 void IssueLogger::silent(bool yesno)
 {
     std::thread::id id = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(_silentMutex);
     if ( yesno == false){
         auto iter = _silentThreads.find(id) ;
         if (iter != _silentThreads.end())
@@ -230,61 +305,73 @@ quint64 IssueLogger::logSql(const QSqlError &err)
 
 IssueObject::IssueType IssueLogger::maxIssueLevel() const
 {
-    int type = IssueObject::itNone;
-    foreach(IssueObject issue, _issues) {
-        type |= issue.type();
-    }
-    if ( type & IssueObject::itCritical)
+    std::lock_guard<std::mutex> lock(_issueMutex);
+    auto present = [this](int type)->bool{
+        for(int bit = 0; bit < 8; ++bit)
+            if ( (type & (1 << bit)) && _typeCounts[bit] > 0)
+                return true;
+        return false;
+    };
+    if ( present(IssueObject::itCritical))
         return IssueObject::itCritical;
-    if ( type & IssueObject::itError)
+    if ( present(IssueObject::itError))
         return IssueObject::itError;
-    if ( type & IssueObject::itWarning)
+    if ( present(IssueObject::itWarning))
         return IssueObject::itWarning;
-    if ( type & IssueObject::itMessage)
+    if ( present(IssueObject::itMessage))
         return IssueObject::itMessage;
     return IssueObject::itNone;
 }
 
 void IssueLogger::copy(QList<IssueObject> &other)
 {
-  foreach(IssueObject issue, _issues) {
-      other.append(issue);
-  }
+    std::lock_guard<std::mutex> lock(_issueMutex);
+    for(const IssueObject& issue : _issues) {
+        other.append(issue);
+    }
 }
 
 QString IssueLogger::popfirst(int tp) {
+    std::lock_guard<std::mutex> lock(_issueMutex);
     if ( tp != IssueObject::itAll){
-        for(auto iter= --_issues.end(); iter != _issues.begin(); --iter ){
+        for(auto iter= _issues.rbegin(); iter != _issues.rend(); ++iter ){
             if (hasType((*iter).type(), tp)){
                 QString mes = (*iter).message();
-                _issues.erase(iter);
+                erase(--iter.base());
                 return mes;
             }
         }
     }
-    if ( _issues.size() > 0)
-        return _issues.dequeue().message();
+    if ( _issues.size() > 0) {
+        QString mes = _issues.front().message();
+        erase(_issues.begin());
+        return mes;
+    }
     return "?";
 }
 
 QString IssueLogger::poplast(int tp) {
+    std::lock_guard<std::mutex> lock(_issueMutex);
     if ( tp != IssueObject::itAll){
         for(auto iter= _issues.begin(); iter != _issues.end(); ++iter ){
             if (hasType((*iter).type(), tp)){
                 QString mes = (*iter).message();
-                _issues.erase(iter);
+                erase(iter);
                 return mes;
             }
         }
     }
-    if ( _issues.size() >0 )
-        return _issues.takeLast().message();
+    if ( _issues.size() >0 ) {
+        QString mes = _issues.back().message();
+        erase(--_issues.end());
+        return mes;
+    }
     return "?";
 }
 
 void IssueLogger::clear() {
+    std::lock_guard<std::mutex> lock(_issueMutex);
     _issues.clear();
+    _issueIndex.clear();
+    std::fill(_typeCounts, _typeCounts + 8, 0);
 }
-
-
-
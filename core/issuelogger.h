@@ -2,10 +2,14 @@
 #define ERRORHANDLING_H
 
 #include <QDateTime>
-#include <QQueue>
+#include <QHash>
 #include <fstream>
 #include <thread>
 #include <map>
+#include <list>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
 #include "kernel_global.h"
 
 class QSqlError;
@@ -50,7 +54,7 @@ public:
     int codeLine() const;
     QString codeFunc() const;
     QString codeFile() const;
-    void stream(std::ofstream &stream, LogMessageFormat frmt);
+    void stream(std::ostream &stream, LogMessageFormat frmt);
 
 
 private:
@@ -91,13 +95,35 @@ signals:
     void updateIssues(const IssueObject& issue);
 
 private:
+    typedef std::list<IssueObject> IssueList;
+
+    // only the most recent issues are retained; older ones have been written to the log files
+    static const quint32 MAXISSUES = 5000;
+
+    void enqueue(const IssueObject& issue);
+    IssueList::iterator erase(IssueList::iterator iter);
+    void writeLog(const IssueObject &issue, IssueObject::LogMessageFormat frmt);
+    void logWriter();
+
     QString _lastmessage;
     quint32 _repeatCount;
     quint64 _issueId=0;
-    QQueue<IssueObject> _issues;
+    IssueList _issues;
+    QHash<quint64, IssueList::iterator> _issueIndex; // latest issue for each id
+    quint32 _typeCounts[8]; // number of retained issues per issue type bit
+    mutable std::mutex _issueMutex;
+
+    // the log files are written by a separate thread so that logging threads never wait on file io
     std::ofstream _logFileRegular;
     std::ofstream _logFileCode;
+    std::deque<std::pair<IssueObject::LogMessageFormat, std::string>> _pendingLogs;
+    std::mutex _logMutex;
+    std::condition_variable _logCondition;
+    bool _stopLogging = false;
+    std::thread _logThread;
+
     static std::map<std::thread::id, bool> _silentThreads;
+    static std::mutex _silentMutex;
 
 };
 }
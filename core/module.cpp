@@ -1,6 +1,11 @@
 #include <QDir>
 #include <QDirIterator>
 #include <QPluginLoader>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDateTime>
+#include <future>
 #include "module.h"
 #include "kernel.h"
 #include "factory.h"
@@ -62,7 +67,11 @@ ModuleMap::~ModuleMap() {
 
 void ModuleMap ::loadPlugin(const QFileInfo& file){
     QPluginLoader loader(file.absoluteFilePath());
+    // loading the library runs the static registration of all its operations; their metadata
+    // is collected and stored in one go before the module itself is prepared
+    mastercatalog()->beginBatch();
     QObject *plugin = loader.instance();
+    mastercatalog()->endBatch();
     if (plugin)  {
         Module *module = qobject_cast<Module *>(plugin);
         if (module != 0) {
@@ -87,20 +96,113 @@ void ModuleMap::addModules() {
         }
     }
 
+    loadManifest();
+    QFileInfoList libs;
     for(auto entry : dirs){
         QStringList exts;
         exts << "*.dll" << "*.so" << "*.DLL" << "*.SO";
         QDir plugindir(entry.absoluteFilePath());
-        QFileInfoList libs = plugindir.entryInfoList(exts, QDir::Files);
-        for( auto lib : libs){
-            loadPlugin(lib);
+        libs.append(plugindir.entryInfoList(exts, QDir::Files));
+    }
+
+    // inspecting the plugin metadata means scanning the library file; for the libraries that are new or changed
+    // since the last start this is done in parallel. It does not load the library, so nothing gets registered yet
+    std::vector<std::pair<QFileInfo, std::future<QString>>> inspections;
+    for(const QFileInfo& lib : libs){
+        if ( isCurrent(lib))
+            continue;
+        inspections.push_back({lib, std::async(std::launch::async, [](const QString& path)->QString{
+            QPluginLoader loader(path);
+            return loader.metaData().value("IID").toString();
+        }, lib.absoluteFilePath())});
+    }
+    bool changed = false;
+    for(auto& inspection : inspections){
+        ManifestEntry entry;
+        entry._size = inspection.first.size();
+        entry._lastModified = inspection.first.lastModified().toMSecsSinceEpoch();
+        entry._iid = inspection.second.get();
+        _manifest[inspection.first.absoluteFilePath()] = entry;
+        changed = true;
+    }
+    for(auto iter = _manifest.begin(); iter != _manifest.end();){
+        if ( !QFileInfo((*iter).first).exists()){
+            iter = _manifest.erase(iter);
+            changed = true;
+        } else
+            ++iter;
+    }
+    if ( changed)
+        storeManifest();
+
+    // loading itself stays sequential; the static registrations and module preparations all write to the shared factories and catalogs.
+    // Every library with plugin metadata is loaded, as before; only libraries that are no plugin at all are skipped
+    for( auto lib : libs){
+        ManifestEntry& entry = _manifest[lib.absoluteFilePath()];
+        if ( entry._iid.isEmpty()) {
+            kernel()->issues()->log(TR("Skipped %1, it is not a plugin").arg(lib.fileName()), IssueObject::itMessage);
+            continue;
         }
+        if ( !entry._iid.startsWith("n52.ilwis."))
+            kernel()->issues()->log(TR("Plugin %1 has the unexpected interface id %2").arg(lib.fileName()).arg(entry._iid), IssueObject::itMessage);
+        loadPlugin(lib);
     }
     QString file = context()->ilwisFolder().absoluteFilePath() + "/httpserver.dll";
     loadPlugin(file);
     initModules();
 }
 
+QString ModuleMap::manifestPath() const
+{
+    return context()->cacheLocation().toLocalFile() + "/plugins.manifest";
+}
+
+bool ModuleMap::isCurrent(const QFileInfo &file) const
+{
+    auto iter = _manifest.find(file.absoluteFilePath());
+    if ( iter == _manifest.end())
+        return false;
+    return (*iter).second._size == file.size() && (*iter).second._lastModified == file.lastModified().toMSecsSinceEpoch();
+}
+
+void ModuleMap::loadManifest()
+{
+    _manifest.clear();
+    QFile file(manifestPath());
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QJsonArray entries = QJsonDocument::fromJson(file.readAll()).array();
+    for(const QJsonValue& value : entries){
+        QJsonObject obj = value.toObject();
+        if ( !obj.contains("iid")) // written by an older version; the library is inspected again
+            continue;
+        ManifestEntry entry;
+        entry._size = obj.value("size").toString().toLongLong();
+        entry._lastModified = obj.value("lastmodified").toString().toLongLong();
+        entry._iid = obj.value("iid").toString();
+        _manifest[obj.value("path").toString()] = entry;
+    }
+}
+
+void ModuleMap::storeManifest() const
+{
+    QJsonArray entries;
+    for(const auto& item : _manifest){
+        QJsonObject obj;
+        obj.insert("path", item.first);
+        // 64 bit values do not survive the conversion to double of QJsonValue, so they are stored as strings
+        obj.insert("size", QString::number(item.second._size));
+        obj.insert("lastmodified", QString::number(item.second._lastModified));
+        obj.insert("iid", item.second._iid);
+        entries.append(obj);
+    }
+    QDir().mkpath(QFileInfo(manifestPath()).absolutePath());
+    QFile file(manifestPath());
+    if ( file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        file.write(QJsonDocument(entries).toJson(QJsonDocument::Compact));
+}
+
 void ModuleMap::initModules(){
     foreach(Module *module,*this)
         module->finalizePreparation();
@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QMap>
+#include <map>
 #include "kernel_global.h"
 
 class QFileInfo;
@@ -94,8 +95,23 @@ public:
     void addModules();
     void initModules();
 private:
+    /*!
+     the manifest remembers for each library in the extension folders (by path, size and modification time) its plugin interface id.
+     Libraries that are known not to be plugins (e.g. support libraries placed next to them) are skipped without inspecting them again.
+     */
+    struct ManifestEntry {
+        qint64 _size = 0;
+        qint64 _lastModified = 0;
+        QString _iid;
+    };
 
     void loadPlugin(const QFileInfo& file);
+    void loadManifest();
+    void storeManifest() const;
+    QString manifestPath() const;
+    bool isCurrent(const QFileInfo& file) const;
+
+    std::map<QString, ManifestEntry> _manifest;
 };
 }
 
@@ -2,6 +2,9 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QSqlRecord>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
 #include <functional>
 #include "kernel.h"
 #include "ilwiscontext.h"
@@ -118,7 +121,11 @@ void PublicDatabase::prepare() {
 
 
 
-    loadPublicTables();
+    if (!restoreSnapshot()) {
+        loadPublicTables();
+        storeSnapshot();
+    }
+    Proj4Parameters::fillLookup(*this);
 
     if ( kernel()->issues()->maxIssueLevel() == IssueObject::itCritical) {
         throw ErrorObject(TR("Critical errors found when initialzing Public database"));
@@ -151,6 +158,8 @@ QString PublicDatabase::findAlias(const QString &name, const QString &type, cons
 }
 
 void PublicDatabase::loadPublicTables() {
+    // a single transaction; sqlite would otherwise commit (and sync) every insert separately
+    transaction();
     QSqlQuery sqlPublic(*this);
     insertFile("datums.csv", sqlPublic);
     insertFile("ellipsoids.csv",sqlPublic);
@@ -160,6 +169,92 @@ void PublicDatabase::loadPublicTables() {
     insertFile("codes_with_latlon_order.csv",sqlPublic);
     insertFile("representations.csv", sqlPublic);
     insertProj4Epsg(sqlPublic);
+    commit();
+}
+
+QStringList PublicDatabase::snapshotTables() const
+{
+    return {"datum","ellipsoid","projection","filters","codes","numericdomain","representation","projectedcsy","epsgcodeswithlatlonaxesorder"};
+}
+
+QString PublicDatabase::snapshotPath() const
+{
+    return context()->cacheLocation().toLocalFile() + "/publicdatabase.snapshot";
+}
+
+QString PublicDatabase::resourceStamp() const
+{
+    auto basePath = context()->ilwisFolder().absoluteFilePath() + "/resources/";
+    QStringList files = {"datums.csv","ellipsoids.csv","projections.csv","numericdomains.csv","filters.csv",
+                         "codes_with_latlon_order.csv","representations.csv","epsg.pcs"};
+    QString stamp = QString::number(SNAPSHOTVERSION);
+    for(const QString& file : files) {
+        QFileInfo info(basePath + file);
+        if ( !info.exists())
+            return sUNDEF; // let the normal loading report the missing file
+        stamp += QString("|%1:%2:%3").arg(file).arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch());
+    }
+    return stamp;
+}
+
+bool PublicDatabase::restoreSnapshot()
+{
+    QString stamp = resourceStamp();
+    QFileInfo info(snapshotPath());
+    if ( stamp == sUNDEF || !info.exists())
+        return false;
+
+    QSqlQuery sql(*this);
+    if (!sql.exec(QString("ATTACH DATABASE '%1' AS snapshot").arg(info.absoluteFilePath().replace("'","''"))))
+        return false;
+
+    bool ok = sql.exec("SELECT stamp FROM snapshot.snapshotinfo") && sql.next() && sql.value(0).toString() == stamp;
+    if ( ok) {
+        transaction();
+        for(const QString& table : snapshotTables()) {
+            if (!(ok = sql.exec(QString("INSERT INTO main.%1 SELECT * FROM snapshot.%1").arg(table))))
+                break;
+        }
+        if ( ok)
+            commit();
+        else
+            rollback();
+    }
+    sql.finish();
+    sql.exec("DETACH DATABASE snapshot");
+    return ok;
+}
+
+void PublicDatabase::storeSnapshot()
+{
+    QString stamp = resourceStamp();
+    if ( stamp == sUNDEF || kernel()->issues()->maxIssueLevel() == IssueObject::itCritical)
+        return;
+
+    // a failing snapshot is not an error; the next start simply parses the resources again
+    QString path = snapshotPath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile::remove(path);
+    QSqlQuery sql(*this);
+    if (!sql.exec(QString("ATTACH DATABASE '%1' AS snapshot").arg(QString(path).replace("'","''"))))
+        return;
+
+    bool ok = true;
+    for(const QString& table : snapshotTables()) {
+        if (!(ok = sql.exec(QString("CREATE TABLE snapshot.%1 AS SELECT * FROM main.%1").arg(table))))
+            break;
+    }
+    // the stamp goes in last, so a partially written snapshot is never accepted
+    ok = ok && sql.exec("CREATE TABLE snapshot.snapshotinfo (stamp TEXT)");
+    ok = ok && sql.prepare("INSERT INTO snapshot.snapshotinfo VALUES(:stamp)");
+    if ( ok) {
+        sql.bindValue(":stamp", stamp);
+        ok = sql.exec();
+    }
+    sql.finish();
+    sql.exec("DETACH DATABASE snapshot");
+    if (!ok)
+        QFile::remove(path);
 }
 void PublicDatabase::insertProj4Epsg(QSqlQuery& sqlPublic) {
     auto basePath = context()->ilwisFolder().absoluteFilePath() + "/resources";
@@ -195,7 +290,6 @@ void PublicDatabase::insertProj4Epsg(QSqlQuery& sqlPublic) {
                 kernel()->issues()->logSql(sqlPublic.lastError());
                 return;
             }
-            Proj4Parameters::add2lookup(name,projTxt,epgsTxt);
             name = "";
         } else if ( line[0] == '#') { // comment line, skip it, next line will be empty
             ++i;
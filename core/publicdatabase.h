@@ -2,6 +2,7 @@
 #define PUBLICDATABASE_H
 
 #include <QSqlDatabase>
+#include <QStringList>
 
 class QSqlRecord;
 
@@ -41,7 +42,21 @@ public:
     QString findAlias(const QString& name, const QString& type, const QString& nspace);
 
 private:
+    static const int SNAPSHOTVERSION = 1;
+
     void loadPublicTables();
+    /*!
+     restoreSnapshot fills the system tables from the snapshot file in the cache location
+
+     The snapshot is only used if its stamp matches the current resource files (sizes and modification times); otherwise
+     the resources are parsed again and a fresh snapshot is written by storeSnapshot.
+     \return bool true if the system tables were restored from the snapshot
+    */
+    bool restoreSnapshot();
+    void storeSnapshot();
+    QString snapshotPath() const;
+    QString resourceStamp() const;
+    QStringList snapshotTables() const;
     void insertFile(const QString &filename, QSqlQuery &sqlPublic);
     bool fillEllipsoidRecord(const QStringList &parts, QSqlQuery &sqlPublic);
     bool fillDatumRecord(const QStringList &parts, QSqlQuery &sqlPublic);
@@ -1,3 +1,4 @@
+#include <chrono>
 #include "kernel.h"
 #include "tranquilizer.h"
 
@@ -6,13 +7,13 @@ using namespace Ilwis;
 quint64 Tranquilizer::_trqId = 0;
 
 Tranquilizer::Tranquilizer(QObject *parent) :
-    QObject(parent)
+    QObject(parent), _id(_trqId++), _end(0), _lastReport(0), _completed(false)
 {
 
 }
 
 Tranquilizer::Tranquilizer(const QString& title, const QString& description, double end) :  QObject(0),
-    _title(title), _desc(description), _end(end)
+    _title(title), _desc(description), _end(end), _lastReport(0), _completed(false)
 {
     _id = _trqId++;
 }
@@ -22,8 +23,10 @@ void Tranquilizer::prepare(const QString &title, const QString &description, dou
     _title = title;
     _desc = description;
     _end = end;
+    _completed = false;
     kernel()->connect(this, &Tranquilizer::updateTranquilizer, kernel(), &Kernel::changeTranquilizer,Qt::DirectConnection);
     kernel()->newTranquilizer(_id, title, description, _end);
+    _prepared = true;
 
 }
 
@@ -37,12 +40,48 @@ double Tranquilizer::end() const
     return _end;
 }
 
+void Tranquilizer::report()
+{
+    if ( !_prepared)
+        return;
+    double cur = current();
+    if ( cur >= _end) {
+        // the end is reported once, without waiting for the interval
+        if ( !_completed.exchange(true))
+            emit(updateTranquilizer(_id, cur));
+        return;
+    }
+    qint64 now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    qint64 last = _lastReport.load(std::memory_order_relaxed);
+    if ( now - last < REPORTINTERVAL)
+        return;
+    // only the thread that succeeds in claiming the interval reports
+    if ( _lastReport.compare_exchange_strong(last, now))
+        emit(updateTranquilizer(_id, cur));
+}
+
+void Tranquilizer::flush()
+{
+    if ( !_prepared)
+        return;
+    double cur = current();
+    if ( cur >= _end && _completed.exchange(true))
+        return; // the end has already been reported
+    emit(updateTranquilizer(_id, cur));
+}
+
 double Tranquilizer::current() const
 {
-    return _current;
+    quint64 total = 0;
+    for(const Slot& slot : _slots)
+        total += slot._count.load(std::memory_order_relaxed);
+    return (double)total / STEPSCALE;
 }
 
 void Tranquilizer::current(double cur)
 {
-    _current = cur;
+    for(Slot& slot : _slots)
+        slot._count.store(0, std::memory_order_relaxed);
+    _slots[0]._count.store((quint64)std::llround(cur * STEPSCALE), std::memory_order_relaxed);
+    _completed.store(cur >= _end && _completed.load());
 }
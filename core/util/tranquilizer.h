@@ -3,9 +3,20 @@
 
 #include <QObject>
 #include <memory>
+#include <atomic>
+#include <thread>
+#include <cmath>
 #include "locker.h"
 
 namespace Ilwis {
+/*!
+ * \brief The Tranquilizer class reports the progress of (long) running processes
+ *
+ * Progress is counted in per thread counters (threads are spread over a fixed number of slots) so that updating doesn't need a lock
+ * and threads don't compete for the same memory. The counters are merged and reported (the updateTranquilizer signal) at most once per
+ * reporting interval, so update() can be called from inner loops. Reaching the end is always reported; flush() reports the final state of
+ * a process that stops before (or without) reaching the end. Steps are counted in fixed point, so fractional steps add up.
+ */
 class KERNELSHARED_EXPORT Tranquilizer : public QObject
 {
     Q_OBJECT
@@ -16,11 +27,16 @@ public:
 
 
     void update(double step) {
-        Locker<std::mutex> lock(_mutex);
-        _current += step;
-        emit(updateTranquilizer(_id, _current));
-
+        Slot& slot = _slots[std::hash<std::thread::id>()(std::this_thread::get_id()) % SLOTCOUNT];
+        slot._count.fetch_add((quint64)std::llround(step * STEPSCALE), std::memory_order_relaxed);
+        // the clock is only consulted every so many updates, unless steps are so large that there are few updates anyway
+        if ( (slot._updates.fetch_add(1, std::memory_order_relaxed) & CHECKMASK) == 0 || (_prepared && step * CHECKMASK >= _end))
+            report();
     }
+    /*!
+     * \brief flush reports the current progress regardless of the reporting interval
+     */
+    void flush();
 
     double current() const;
     void current(double cur);
@@ -28,13 +44,29 @@ public:
     double end() const;
 
 private:
+    static const quint32 SLOTCOUNT = 16;
+    static const quint32 CHECKMASK = 0xFF;
+    static const qint64 REPORTINTERVAL = 100; // milliseconds
+    static const quint64 STEPSCALE = 1 << 16; // counts are fixed point numbers with 16 fraction bits
+
+    struct Slot {
+        Slot() : _count(0), _updates(0) {}
+        std::atomic<quint64> _count;
+        std::atomic<quint32> _updates;
+        char _padding[64 - sizeof(std::atomic<quint64>) - sizeof(std::atomic<quint32>)]; // one slot per cache line
+    };
+
+    void report();
+
     static quint64 _trqId;
     quint64 _id;
     QString _title;
     QString _desc;
     double  _end;
-    double _current;
-    std::mutex _mutex;
+    Slot _slots[SLOTCOUNT];
+    std::atomic<qint64> _lastReport;
+    std::atomic<bool> _completed;
+    bool _prepared = false;
 signals:
     void updateTranquilizer(quint64 id, double current);
     void tranquilizerCreated(quint64 id, const QString &title, const QString &description, quint64 end);
@@ -39,6 +39,7 @@ bool PointRasterCrossing::execute(ExecutionContext *ctx, SymbolTable &symTable)
             return false;
 
     quint32 record = 0;
+    GeoRefTransform transform = _inputRaster->georeference()->transform();
     for(const auto& infeature : _inputFeatures){
         if ( infeature->geometryType() != itPOINT)
             continue;
@@ -51,7 +52,7 @@ bool PointRasterCrossing::execute(ExecutionContext *ctx, SymbolTable &symTable)
             continue;
         Coordinate coord =  _doCoordTransform ? _outputFeatures->coordinateSystem()->coord2coord(_inputRaster->coordinateSystem(), *crd) : *crd;
 
-        Pixel pix = _inputRaster->georeference()->coord2Pixel(coord);
+        Pixel pix = transform.coord2Pixel(coord);
         for(int z = 0; z < _inputRaster->size().zsize(); ++z){
             pix.z = z;
             double v = _inputRaster->pix2value(pix);
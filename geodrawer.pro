@@ -48,7 +48,9 @@ SOURCES += \
     geodrawer/tesselation/sweep.c \
     geodrawer/tesselation/tess.c \
     geodrawer/tesselation/ilwistesselator.cpp \
-    geodrawer/attributevisualproperties.cpp
+    geodrawer/attributevisualproperties.cpp \
+    geodrawer/rastertilerenderer.cpp \
+    geodrawer/rasterlayerdrawer.cpp
 
 HEADERS += \
     geodrawer/geodrawer_plugin.h \
@@ -74,7 +76,9 @@ HEADERS += \
     geodrawer/tesselation/tess.h \
     geodrawer/tesselation/tesselator.h \
     geodrawer/tesselation/ilwistesselator.h \
-    geodrawer/attributevisualproperties.h
+    geodrawer/attributevisualproperties.h \
+    geodrawer/rastertilerenderer.h \
+    geodrawer/rasterlayerdrawer.h
 
 OTHER_FILES = geodrawer/qmldir
 
@@ -3,6 +3,7 @@
 #include "ilwisdata.h"
 #include "domain.h"
 #include "colorlookup.h"
+#include "colortable.h"
 #include "range.h"
 #include "numericrange.h"
 #include "representation.h"
@@ -28,6 +29,8 @@ AttributeVisualProperties::AttributeVisualProperties(const AttributeVisualProper
     _actualRange = avp._actualRange;
     _stretchRange = avp._stretchRange;
     _domain = avp._domain;
+    _colorTable = avp._colorTable;
+    _compiledVersion = avp._compiledVersion;
 }
 
 IRepresentation AttributeVisualProperties::representation() const
@@ -41,6 +44,7 @@ void AttributeVisualProperties::representation(const IRepresentation &rpr)
         return;
     if ( rpr->isCompatible(_domain)){
         _representation = rpr;
+        _compiledVersion = 0;
     }
 }
 
@@ -55,6 +59,7 @@ void AttributeVisualProperties::domain(const IDomain &dom)
         _representation = IRepresentation();
     }
     _domain = dom;
+    _compiledVersion = 0;
 }
 
 NumericRange AttributeVisualProperties::stretchRange() const
@@ -65,11 +70,27 @@ NumericRange AttributeVisualProperties::stretchRange() const
 void AttributeVisualProperties::stretchRange(const NumericRange &rng)
 {
     _stretchRange = rng;
+    _compiledVersion = 0;
 }
 
 QColor AttributeVisualProperties::value2color(const QVariant &var)
 {
-    return _representation->colors()->value2color(var.toDouble(), _actualRange, _stretchRange) ;
+    return colorTable().value2color(var.toDouble());
+}
+
+const ColorTable &AttributeVisualProperties::colorTable()
+{
+    if ( !_representation.isValid() || !_representation->colors()){
+        _colorTable = ColorTable();
+        _compiledVersion = 0;
+    } else if ( _compiledVersion != _representation->colors()->version()){
+        quint32 indexCount = iUNDEF;
+        if ( _domain.isValid() && hasType(_domain->ilwisType(), itITEMDOMAIN) && _actualRange.isValid())
+            indexCount = _actualRange.max() + 1;
+        _colorTable = ColorTable(*_representation->colors(), _actualRange, _stretchRange, indexCount);
+        _compiledVersion = _representation->colors()->version();
+    }
+    return _colorTable;
 }
 
 NumericRange AttributeVisualProperties::actualRange() const
@@ -80,6 +101,7 @@ NumericRange AttributeVisualProperties::actualRange() const
 void AttributeVisualProperties::actualRange(const NumericRange &rng)
 {
     _actualRange = rng;
+    _compiledVersion = 0;
 }
 
 
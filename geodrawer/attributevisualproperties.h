@@ -1,6 +1,8 @@
 #ifndef ATTRIBUTEVISUALPROPERTIES_H
 #define ATTRIBUTEVISUALPROPERTIES_H
 
+#include "colortable.h"
+
 namespace Ilwis {
 
 class Representation;
@@ -25,6 +27,10 @@ public:
     NumericRange stretchRange() const;
     void stretchRange(const NumericRange& rng);
     QColor value2color(const QVariant& var);
+    /*!
+     * \brief colorTable the representation compiled for the current ranges; it is recompiled when the representation or one of the ranges changed
+     */
+    const ColorTable& colorTable();
     NumericRange actualRange() const;
     void actualRange(const NumericRange& rng);
 
@@ -34,6 +40,8 @@ private:
     NumericRange _stretchRange;
     NumericRange _actualRange;
     IDomain _domain;
+    ColorTable _colorTable;
+    quint64 _compiledVersion = 0; // version (see ColorLookUp::version) of the lookup from which _colorTable was made, 0 if it must be recompiled
 };
 }
 }
@@ -1,3 +1,4 @@
+#include <future>
 #include "coverage.h"
 #include "featurecoverage.h"
 #include "feature.h"
@@ -15,6 +16,7 @@
 #include "featurelayerdrawer.h"
 #include "tesselation/ilwistesselator.h"
 #include "openglhelper.h"
+#include "geos/index/strtree/STRtree.h"
 
 using namespace Ilwis;
 using namespace Geodrawer;
@@ -25,6 +27,10 @@ FeatureLayerDrawer::FeatureLayerDrawer(DrawerInterface *parentDrawer, RootDrawer
 {
 }
 
+FeatureLayerDrawer::~FeatureLayerDrawer()
+{
+}
+
 DrawerInterface *FeatureLayerDrawer::create(DrawerInterface *parentDrawer, RootDrawer *rootdrawer)
 {
     return new FeatureLayerDrawer(parentDrawer, rootdrawer)    ;
@@ -36,17 +42,23 @@ bool FeatureLayerDrawer::prepare(DrawerInterface::PreparationType prepType, cons
     if(!LayerDrawer::prepare(prepType, options, openglContext))
         return false;
 
+    IFeatureCoverage features = coverage().as<FeatureCoverage>();
+    if ( !features.isValid()){
+        return ERROR2(ERR_COULDNT_CREATE_OBJECT_FOR_2,"FeatureCoverage", TR("Visualization"));
+    }
+    // zooming may require geometries at another level of detail
+    quint32 level = detailLevel(features);
+    if ( level != _detailLevel){
+        _detailLevel = level;
+        _prepared &= ~ptGEOMETRY;
+    }
+
     if ( hasType(prepType, DrawerInterface::ptGEOMETRY) && !isPrepared(DrawerInterface::ptGEOMETRY)){
         std::vector<VertexPosition> vertices;
         std::vector<VertexColor> colors;
 
         _indices = std::vector<VertexIndex>();
 
-
-        IFeatureCoverage features = coverage().as<FeatureCoverage>();
-        if ( !features.isValid()){
-            return ERROR2(ERR_COULDNT_CREATE_OBJECT_FOR_2,"FeatureCoverage", TR("Visualization"));
-        }
         AttributeVisualProperties attr = visualAttribute(activeAttribute());
         int columnIndex = features->attributeDefinitions().columnIndex(activeAttribute());
         if ( columnIndex == iUNDEF){ // test a number of fallbacks to be able to show at least something
@@ -59,30 +71,241 @@ bool FeatureLayerDrawer::prepare(DrawerInterface::PreparationType prepType, cons
                     return false;
             }
         }
+        // attribute values are read sequentially; building the vertices and colors is done in parallel for ranges of features
+        // a restyle doesn't change the triangulations so the cached ones can be reused; each feature owns its own
+        // cache entry so the batches can update them without locking
+        ICoordinateSystem csyRoot = rootDrawer()->coordinateSystem();
+        ICoordinateSystem csyFeatures = features->coordinateSystem();
+        std::pair<quint64, quint64> csys(csyRoot->id(), csyFeatures->id());
+        if ( csys != _detailCsys || _details.size() != DETAILLEVELS + 1){
+            _details = std::vector<std::unordered_map<quint64, FeatureDetail>>(DETAILLEVELS + 1);
+            _detailCsys = csys;
+        }
+        std::unordered_map<quint64, FeatureDetail> oldDetails;
+        oldDetails.swap(_details[_detailLevel]);
+        std::unordered_map<quint64, FeatureDetail>& details = _details[_detailLevel];
+        double tolerance = detailTolerance(features, _detailLevel);
+
+        std::vector<std::pair<SPFeatureI, QVariant>> visibleFeatures;
+        std::vector<FeatureDetail *> featureDetails;
+        visibleFeatures.reserve(features->featureCount());
+        featureDetails.reserve(features->featureCount());
         for(const SPFeatureI& feature : features){
             QVariant value =  feature(columnIndex);
             if ( value.toInt() != iUNDEF) {
-                quint32 noOfVertices = OpenGLHelper::getVertices(rootDrawer()->coordinateSystem(), features->coordinateSystem(), feature->geometry(), feature->featureid(), vertices, _indices, _boundaryIndex);
-                for(int i =0; i < noOfVertices; ++i){
-                    if ( _boundaryIndex == iUNDEF || i < _boundaryIndex){
-                        QColor clr = attr.value2color(value);
-                        colors.push_back(VertexColor(clr.redF(), clr.greenF(), clr.blueF(), 1.0));
-                    }else {
-                        colors.push_back(VertexColor(128,0,128,1));
+                visibleFeatures.push_back({feature, value});
+                FeatureDetail& detail = details[feature->featureid()];
+                auto iter = oldDetails.find(feature->featureid());
+                if ( iter != oldDetails.end() && (*iter).second._geometryVersion == feature->geometryVersion())
+                    detail = std::move((*iter).second);
+                detail._geometryVersion = feature->geometryVersion();
+                featureDetails.push_back(&detail);
+            }
+        }
+        oldDetails.clear();
+
+        // colors are mapped in one pass over all values through the compiled representation
+        std::vector<double> values(visibleFeatures.size());
+        for(quint32 f = 0; f < visibleFeatures.size(); ++f)
+            values[f] = visibleFeatures[f].second.toDouble();
+        std::vector<QRgb> featureColors(visibleFeatures.size());
+        attr.colorTable().values2rgba(values.data(), values.size(), featureColors.data());
+
+        struct VertexBatch {
+            std::vector<VertexPosition> _vertices;
+            std::vector<VertexColor> _colors;
+            std::vector<VertexIndex> _indices;
+        };
+        auto buildBatch = [&](quint32 start, quint32 end, VertexBatch& batch)->bool{
+            for(quint32 f = start; f < end; ++f){
+                const SPFeatureI& feature = visibleFeatures[f].first;
+                FeatureDetail *detail = featureDetails[f];
+                if ( tolerance > 0 && !detail->_simplified){
+                    detail->_geometry = OpenGLHelper::simplify(feature->geometry(), tolerance);
+                    detail->_simplified = true;
+                }
+                const SPGeometry& geometry = detail->_geometry ? detail->_geometry : feature->geometry();
+                quint32 noOfVertices = OpenGLHelper::getVertices(csyRoot, csyFeatures, geometry, feature->featureid(), batch._vertices, batch._indices, &detail->_tesselation);
+                QRgb clr = featureColors[f];
+                VertexColor color(qRed(clr) / 255.0, qGreen(clr) / 255.0, qBlue(clr) / 255.0, 1.0);
+                for(quint32 i =0; i < noOfVertices; ++i)
+                    batch._colors.push_back(color);
+            }
+            return true;
+        };
+
+        quint32 cores = std::max(1u, std::thread::hardware_concurrency());
+        quint32 batchCount = std::max(1u, std::min(cores, (quint32)visibleFeatures.size() / MINFEATURESPERBATCH));
+        quint32 batchSize = (visibleFeatures.size() + batchCount - 1) / batchCount;
+        std::vector<VertexBatch> batches(batchCount);
+        std::vector<std::future<bool>> futures(batchCount);
+        for(quint32 i = 0; i < batchCount; ++i) {
+            quint32 start = std::min((quint32)visibleFeatures.size(), i * batchSize);
+            quint32 end = std::min((quint32)visibleFeatures.size(), start + batchSize);
+            futures[i] = std::async(std::launch::async, buildBatch, start, end, std::ref(batches[i]));
+        }
+        bool ok = true;
+        for(auto& future : futures)
+            ok &= future.get();
+        if (!ok)
+            return false;
+
+        quint32 vertexCount = 0, indexCount = 0;
+        for(const VertexBatch& batch : batches){
+            vertexCount += batch._vertices.size();
+            indexCount += batch._indices.size();
+        }
+        vertices.reserve(vertexCount);
+        colors.reserve(vertexCount);
+        _indices.reserve(indexCount);
+        for(VertexBatch& batch : batches){
+            quint32 offset = vertices.size();
+            vertices.insert(vertices.end(), batch._vertices.begin(), batch._vertices.end());
+            colors.insert(colors.end(), batch._colors.begin(), batch._colors.end());
+            for(VertexIndex& index : batch._indices){
+                index._start += offset;
+                _indices.push_back(index);
+            }
+            batch = VertexBatch();
+        }
+
+        // all parts are drawn with one call per primitive type; fans and strips are turned into triangle and segment lists.
+        // the elements of a feature are contiguous within each list so that the parts of the view can be drawn per feature
+        std::vector<quint32> triangles, lines;
+        triangles.reserve(vertexCount * 3);
+        lines.reserve(vertexCount * 2);
+        _featureRanges.clear();
+        _featureEnvelopes.clear();
+        for(quint32 i = 0; i < _indices.size(); ){
+            FeatureRange range;
+            range._triangleStart = triangles.size();
+            range._lineStart = lines.size();
+            geos::geom::Envelope envelope;
+            Raw objectid = _indices[i]._objectid;
+            for(; i < _indices.size() && _indices[i]._objectid == objectid; ++i){
+                const VertexIndex& index = _indices[i];
+                for(quint32 v = index._start; v < index._start + index._count; ++v)
+                    envelope.expandToInclude(vertices[v]._x, vertices[v]._y);
+                if ( index._geomtype == itPOLYGON){
+                    for(quint32 v = 2; v < index._count; ++v){
+                        triangles.push_back(index._start);
+                        triangles.push_back(index._start + v - 1);
+                        triangles.push_back(index._start + v);
+                    }
+                } else if ( index._geomtype == itLINE){
+                    for(quint32 v = 1; v < index._count; ++v){
+                        lines.push_back(index._start + v - 1);
+                        lines.push_back(index._start + v);
                     }
                 }
-                if(!initGeometry(openglContext, vertices, colors))
-                    return false;
             }
+            range._triangleCount = triangles.size() - range._triangleStart;
+            range._lineCount = lines.size() - range._lineStart;
+            _featureRanges.push_back(range);
+            _featureEnvelopes.push_back(envelope);
+        }
+        _triangleElements = triangles.size();
+        _lineElements = lines.size();
+        triangles.insert(triangles.end(), lines.begin(), lines.end());
+        lines = std::vector<quint32>();
+
+        // the tree refers to the envelopes, they don't change until the next preparation
+        _drawIndex.reset(new geos::index::strtree::STRtree());
+        for(quint32 f = 0; f < _featureEnvelopes.size(); ++f){
+            if ( !_featureEnvelopes[f].isNull())
+                _drawIndex->insert(&_featureEnvelopes[f], (void *)(quintptr)f);
+        }
+        _drawIndex->build();
+        _culledEnvelope = geos::geom::Envelope();
 
-            _prepared |= DrawerInterface::ptGEOMETRY;
+        if(!initGeometry(openglContext, vertices, colors, triangles))
+            return false;
 
-        }
+        _prepared |= DrawerInterface::ptGEOMETRY;
     }
 
     return true;
 }
 
+void FeatureLayerDrawer::updateDrawLists()
+{
+    Envelope zoom = rootDrawer()->zoomEnvelope();
+    geos::geom::Envelope view;
+    if ( zoom.isValid() && !zoom.isNull())
+        view = geos::geom::Envelope(zoom.min_corner().x, zoom.max_corner().x, zoom.min_corner().y, zoom.max_corner().y);
+    // the draw lists cover the view plus a margin, small pans and zooms within that area don't need new lists
+    if ( !_culledEnvelope.isNull() && !view.isNull() && _culledEnvelope.contains(view))
+        return;
+
+    _triangleDraws.clear();
+    _lineDraws.clear();
+    if ( view.isNull() || !_drawIndex){
+        if ( _triangleElements > 0)
+            _triangleDraws.push_back({0, _triangleElements});
+        if ( _lineElements > 0)
+            _lineDraws.push_back({0, _lineElements});
+        _culledEnvelope = geos::geom::Envelope();
+        return;
+    }
+    view.expandBy(view.getWidth() * CULLMARGIN, view.getHeight() * CULLMARGIN);
+    _culledEnvelope = view;
+
+    std::vector<void *> items;
+    _drawIndex->query(&view, items);
+    std::vector<quint32> visible;
+    visible.reserve(items.size());
+    for(void *item : items)
+        visible.push_back((quint32)(quintptr)item);
+    std::sort(visible.begin(), visible.end());
+
+    // ranges of consecutive features are merged into one draw call
+    auto addRange = [](std::vector<std::pair<quint32, quint32>>& draws, quint32 start, quint32 count){
+        if ( count == 0)
+            return;
+        if ( draws.size() > 0 && draws.back().first + draws.back().second == start)
+            draws.back().second += count;
+        else
+            draws.push_back({start, count});
+    };
+    for(quint32 f : visible){
+        const FeatureRange& range = _featureRanges[f];
+        addRange(_triangleDraws, range._triangleStart, range._triangleCount);
+        addRange(_lineDraws, range._lineStart, range._lineCount);
+    }
+}
+
+quint32 FeatureLayerDrawer::detailLevel(const IFeatureCoverage &features) const
+{
+    double pixelSize = rootDrawer()->pixelSize();
+    if ( pixelSize == rUNDEF || !rootDrawer()->coordinateSystem().isValid())
+        return 0;
+    Envelope envelope = features->envelope();
+    if ( !envelope.isValid())
+        return 0;
+    // the pixel size is in the units of the root coordinate system, the tolerances in those of the features
+    if ( rootDrawer()->coordinateSystem() != features->coordinateSystem()){
+        Envelope rootEnvelope = rootDrawer()->coordinateSystem()->convertEnvelope(features->coordinateSystem(), envelope);
+        if ( !rootEnvelope.isValid() || rootEnvelope.xlength() == 0)
+            return 0;
+        pixelSize *= envelope.xlength() / rootEnvelope.xlength();
+    }
+    quint32 level = 0;
+    for(quint32 l = 1; l <= DETAILLEVELS; ++l){
+        if ( detailTolerance(features, l) <= pixelSize)
+            level = l;
+    }
+    return level;
+}
+
+double FeatureLayerDrawer::detailTolerance(const IFeatureCoverage &features, quint32 level) const
+{
+    if ( level == 0)
+        return 0;
+    Envelope envelope = features->envelope();
+    double extent = std::max(envelope.xlength(), envelope.ylength());
+    return extent * (1 << (2 * (level - 1))) / DETAILBASE;
+}
+
 void FeatureLayerDrawer::unprepare(DrawerInterface::PreparationType prepType)
 {
     LayerDrawer::unprepare(prepType);
@@ -171,16 +394,14 @@ bool FeatureLayerDrawer::draw(QOpenGLContext *openglContext, const IOOptions&) {
     openglContext->functions()->glVertexAttribPointer(colorLocation,4,GL_FLOAT,FALSE,0, 0);
     openglContext->functions()->glEnableVertexAttribArray(colorLocation);
 
+    openglContext->functions()->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,_vboIndices);
+    updateDrawLists();
+    for(const auto& range : _triangleDraws)
+        glDrawElements(GL_TRIANGLES, range.second, GL_UNSIGNED_INT, (const GLvoid *)(sizeof(quint32) * range.first));
+    for(const auto& range : _lineDraws)
+        glDrawElements(GL_LINES, range.second, GL_UNSIGNED_INT, (const GLvoid *)(sizeof(quint32) * (_triangleElements + range.first)));
 
-
-    for(int i =0; i < _indices.size(); ++i){
-        if ( _indices[i]._geomtype == itLINE){
-            glDrawArrays(GL_LINE_STRIP,_indices[i]._start,_indices[i]._count);
-        } else if ( _indices[i]._geomtype == itPOLYGON ){
-            glDrawArrays(GL_TRIANGLE_FAN,_indices[i]._start,_indices[i]._count);
-        }
-    }
-
+    openglContext->functions()->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     openglContext->functions()->glBindBuffer(GL_ARRAY_BUFFER, 0);
     openglContext->functions()->glDisableVertexAttribArray(colorLocation);
     openglContext->functions()->glDisableVertexAttribArray(vertexLocation);
@@ -1,7 +1,18 @@
 #ifndef FEATURELAYERDRAWER_H
 #define FEATURELAYERDRAWER_H
 
+#include <unordered_map>
+#include "geos/geom/Envelope.h"
 #include "layerdrawer.h"
+#include "openglhelper.h"
+
+namespace geos{
+namespace index {
+namespace strtree {
+class STRtree;
+}
+}
+}
 
 namespace Ilwis {
 namespace Geodrawer{
@@ -11,6 +22,7 @@ class FeatureLayerDrawer : public LayerDrawer
 {
 public:
     FeatureLayerDrawer(DrawerInterface* parentDrawer, RootDrawer *rootdrawer);
+    ~FeatureLayerDrawer();
     bool prepare(PreparationType prepType, const IOOptions& options,QOpenGLContext *openglContext=0);
     void unprepare(DrawerInterface::PreparationType prepType);
 
@@ -25,8 +37,50 @@ public:
 
 
 private:
+    // below this number of features per thread the vertices are built by fewer threads
+    static const quint32 MINFEATURESPERBATCH = 256;
+    // number of simplified versions of the geometries; level n uses a tolerance of the layer extent / (DETAILBASE / 4^(n-1))
+    static const quint32 DETAILLEVELS = 4;
+    static const quint32 DETAILBASE = 16384;
+    // fraction of the view size added on each side of the view when selecting the features to draw
+    static constexpr double CULLMARGIN = 0.25;
+
+    /*!
+     * derived data of a feature geometry at one level of detail, valid as long as the geometry version of the feature doesn't change.
+     * _geometry is empty at the full level of detail or when simplification wasn't possible
+     */
+    struct FeatureDetail {
+        quint32 _geometryVersion = iUNDEF;
+        bool _simplified = false;
+        SPGeometry _geometry;
+        Tesselation _tesselation;
+    };
+
+    // element ranges of one feature; line elements are relative to the start of the lines in the element buffer
+    struct FeatureRange {
+        quint32 _triangleStart = 0;
+        quint32 _triangleCount = 0;
+        quint32 _lineStart = 0;
+        quint32 _lineCount = 0;
+    };
+
     std::vector<VertexIndex> _indices;
-    quint32 _boundaryIndex = iUNDEF;
+    std::vector<FeatureRange> _featureRanges;
+    std::vector<geos::geom::Envelope> _featureEnvelopes; // in the coordinate system of the rootdrawer
+    std::unique_ptr<geos::index::strtree::STRtree> _drawIndex;
+    geos::geom::Envelope _culledEnvelope; // area covered by the current draw lists
+    std::vector<std::pair<quint32, quint32>> _triangleDraws; // start and count of the element ranges that are drawn
+    std::vector<std::pair<quint32, quint32>> _lineDraws;
+    quint32 _triangleElements = 0; // triangle elements come first in the element buffer, followed by the line segments
+    quint32 _lineElements = 0;
+    // per level of detail the simplified geometries and triangulations by feature id; they are valid for the coordinate systems of _detailCsys
+    std::vector<std::unordered_map<quint64, FeatureDetail>> _details;
+    std::pair<quint64, quint64> _detailCsys = {i64UNDEF, i64UNDEF};
+    quint32 _detailLevel = 0;
+
+    void updateDrawLists();
+    quint32 detailLevel(const IFeatureCoverage& features) const;
+    double detailTolerance(const IFeatureCoverage& features, quint32 level) const;
 
     bool draw(QOpenGLContext *openglContext, const IOOptions &options);
 };
@@ -82,18 +82,29 @@ bool LayerDrawer::initShaders() {
     return true;
 }
 
-bool LayerDrawer::initGeometry(QOpenGLContext *openglContext, const std::vector<VertexPosition> &vertices,const std::vector<VertexColor>& colors) {
+bool LayerDrawer::initGeometry(QOpenGLContext *openglContext, const std::vector<VertexPosition> &vertices,const std::vector<VertexColor>& colors, const std::vector<quint32> &elements) {
     if ( !openglContext){
         return ERROR2(QString("%1 : %2"),TR("Drawing failed"),TR("Invalid OpenGL context passed"));
     }
 
-    openglContext->functions()->glGenBuffers (1, &_vboPosition);
+    // buffers of a previous preparation are reused
+    if ( _vboPosition == 0)
+        openglContext->functions()->glGenBuffers (1, &_vboPosition);
     openglContext->functions()->glBindBuffer (GL_ARRAY_BUFFER, _vboPosition);
-    openglContext->functions()->glBufferData (GL_ARRAY_BUFFER, sizeof (VertexPosition) * vertices.size(), &vertices[0], GL_STATIC_DRAW);
+    openglContext->functions()->glBufferData (GL_ARRAY_BUFFER, sizeof (VertexPosition) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
 
-    openglContext->functions()->glGenBuffers (1, &_vboColor);
+    if ( _vboColor == 0)
+        openglContext->functions()->glGenBuffers (1, &_vboColor);
     openglContext->functions()->glBindBuffer (GL_ARRAY_BUFFER, _vboColor);
-    openglContext->functions()->glBufferData (GL_ARRAY_BUFFER, sizeof (VertexColor) * colors.size(), &colors[0], GL_STATIC_DRAW);
+    openglContext->functions()->glBufferData (GL_ARRAY_BUFFER, sizeof (VertexColor) * colors.size(), colors.data(), GL_STATIC_DRAW);
+
+    if ( elements.size() > 0 || _vboIndices != 0){
+        if ( _vboIndices == 0)
+            openglContext->functions()->glGenBuffers (1, &_vboIndices);
+        openglContext->functions()->glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, _vboIndices);
+        openglContext->functions()->glBufferData (GL_ELEMENT_ARRAY_BUFFER, sizeof (quint32) * elements.size(), elements.data(), GL_STATIC_DRAW);
+        openglContext->functions()->glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
 
     GLenum err =  glGetError();
     if ( err != 0) {
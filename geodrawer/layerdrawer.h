@@ -32,10 +32,11 @@ public:
     QColor color(const IRepresentation& rpr, double value, ColorValueMeaning cvm = cvmTRUEVALUE);
 
 protected:
-    bool initGeometry(QOpenGLContext *openglContext, const std::vector<VertexPosition>& vertices, const std::vector<VertexColor> &colors);
+    bool initGeometry(QOpenGLContext *openglContext, const std::vector<VertexPosition>& vertices, const std::vector<VertexColor> &colors, const std::vector<quint32>& elements=std::vector<quint32>());
     virtual void setActiveVisualAttribute(const QString& attr);
-    GLuint _vboPosition;
-    GLuint _vboColor;
+    GLuint _vboPosition = 0;
+    GLuint _vboColor = 0;
+    GLuint _vboIndices = 0;
     QOpenGLShaderProgram _shaders;
 
 private:
@@ -4,6 +4,9 @@
 #include "coordinatesystem.h"
 #include "geos/geom/Geometry.h"
 #include "geos/geom/CoordinateSequence.h"
+#include "geos/simplify/TopologyPreservingSimplifier.h"
+#include "geos/simplify/DouglasPeuckerSimplifier.h"
+#include "geos/util/GEOSException.h"
 #include "drawers/drawerinterface.h"
 #include "geometryhelper.h"
 #include "tesselation/ilwistesselator.h"
@@ -13,8 +16,6 @@
 using namespace Ilwis;
 using namespace Geodrawer;
 
-IlwisTesselator OpenGLHelper::_tesselator;
-
 OpenGLHelper::OpenGLHelper()
 {
 }
@@ -22,19 +23,18 @@ OpenGLHelper::OpenGLHelper()
 
 quint32 OpenGLHelper::getVertices(const ICoordinateSystem& csyRoot,
                                const ICoordinateSystem& csyGeom,
-                               const Ilwis::UPGeometry &geometry,
+                               const Ilwis::SPGeometry &geometry,
                                Raw objectid,
                                std::vector<VertexPosition> &points,
                                std::vector<VertexIndex> &indices,
-                               quint32& boundaryIndex)
+                               Tesselation *tesselation)
 {
     quint32 oldNumberOfVertices = points.size();
     IlwisTypes tp =  GeometryHelper::geometryType(geometry.get());
 
        switch( tp)     {
         case itPOLYGON:
-            getPolygonVertices(csyRoot, csyGeom, geometry, objectid, points, indices);
-            //boundaryIndex = indices.size();
+            getPolygonVertices(csyRoot, csyGeom, geometry, objectid, points, indices, tesselation);
             //getLineVertices(csyRoot, csyGeom,geometry, objectid, points, indices); break;
         case itLINE:
             getLineVertices(csyRoot, csyGeom,geometry, objectid, points, indices); break;
@@ -47,24 +47,64 @@ quint32 OpenGLHelper::getVertices(const ICoordinateSystem& csyRoot,
 
 }
 
+UPGeometry OpenGLHelper::simplify(const SPGeometry &geometry, double tolerance)
+{
+    if ( !geometry || tolerance <= 0)
+        return UPGeometry();
+    try {
+        switch(GeometryHelper::geometryType(geometry.get())){
+        case itPOLYGON:
+            return UPGeometry(geos::simplify::TopologyPreservingSimplifier::simplify(geometry.get(), tolerance).release());
+        case itLINE:
+            return UPGeometry(geos::simplify::DouglasPeuckerSimplifier::simplify(geometry.get(), tolerance).release());
+        default:
+            break;
+        }
+    } catch(const geos::util::GEOSException& ){
+        // the original geometry will be used
+    }
+    return UPGeometry();
+}
+
 void OpenGLHelper::getPolygonVertices(const ICoordinateSystem& csyRoot,
                                       const ICoordinateSystem& csyGeom,
-                                      const Ilwis::UPGeometry &geometry,
+                                      const Ilwis::SPGeometry &geometry,
                                       Raw objectid,
                                       std::vector<VertexPosition> &points,
-                                      std::vector<VertexIndex> &indices){
+                                      std::vector<VertexIndex> &indices,
+                                      Tesselation *tesselation){
+    if ( tesselation && tesselation->_valid){
+        quint32 offset = points.size();
+        points.insert(points.end(), tesselation->_points.begin(), tesselation->_points.end());
+        for(VertexIndex index : tesselation->_indices){
+            index._start += offset;
+            indices.push_back(index);
+        }
+        return;
+    }
+    // the tesselator keeps state while tesselating, each thread that prepares vertices gets its own
+    static thread_local IlwisTesselator tesselator;
+    quint32 oldPointCount = points.size();
+    quint32 oldIndexCount = indices.size();
     int n = geometry->getNumGeometries();
     for(int  geom = 0; geom < n; ++geom ){
         const geos::geom::Geometry *subgeom = geometry->getGeometryN(geom);
         if (!subgeom)
             continue;
-        _tesselator.tesselate(csyRoot,csyGeom, subgeom,objectid, points, indices);
+        tesselator.tesselate(csyRoot,csyGeom, subgeom,objectid, points, indices);
+    }
+    if ( tesselation){
+        tesselation->_points.assign(points.begin() + oldPointCount, points.end());
+        tesselation->_indices.assign(indices.begin() + oldIndexCount, indices.end());
+        for(VertexIndex& index : tesselation->_indices)
+            index._start -= oldPointCount;
+        tesselation->_valid = true;
     }
 }
 
 void OpenGLHelper::getLineVertices(const ICoordinateSystem& csyRoot,
                                    const ICoordinateSystem& csyGeom,
-                                   const Ilwis::UPGeometry &geometry,
+                                   const Ilwis::SPGeometry &geometry,
                                    Raw objectid,
                                    std::vector<VertexPosition> &points,
                                    std::vector<VertexIndex> &indices){
@@ -92,6 +132,6 @@ void OpenGLHelper::getLineVertices(const ICoordinateSystem& csyRoot,
 
 }
 
-void OpenGLHelper::getPointVertices(const ICoordinateSystem& csyRoot, const ICoordinateSystem& csyGeom, const Ilwis::UPGeometry &geometry, Raw objectid, std::vector<VertexPosition> &points, std::vector<VertexIndex> &indices){
+void OpenGLHelper::getPointVertices(const ICoordinateSystem& csyRoot, const ICoordinateSystem& csyGeom, const Ilwis::SPGeometry &geometry, Raw objectid, std::vector<VertexPosition> &points, std::vector<VertexIndex> &indices){
 
 }
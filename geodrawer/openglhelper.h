@@ -9,24 +9,41 @@ namespace geom{
 
 namespace Ilwis{
 typedef std::unique_ptr<geos::geom::Geometry> UPGeometry;
+typedef std::shared_ptr<const geos::geom::Geometry> SPGeometry;
 class CoordinateSystem;
 typedef IlwisData<CoordinateSystem> ICoordinateSystem;
 
 namespace Geodrawer {
 
+/*!
+ * \brief The Tesselation struct holds the triangulation of a polygon geometry so that it can be reused when a layer is prepared again
+ *
+ * The start of the indices is relative to the first point of the tesselation. The owner of the tesselation decides for which
+ * geometry version and coordinate systems it is valid and resets it when these change.
+ */
+struct Tesselation {
+    bool _valid = false;
+    std::vector<VertexPosition> _points;
+    std::vector<VertexIndex> _indices;
+};
 
 class OpenGLHelper
 {
 public:
     OpenGLHelper();
 
-    static quint32 getVertices(const ICoordinateSystem& csyRoot, const ICoordinateSystem& csyGeom, const UPGeometry& geometry, Raw objectid, std::vector<VertexPosition>& points,  std::vector<VertexIndex>& indices, quint32 &boundaryIndex);
+    static quint32 getVertices(const ICoordinateSystem& csyRoot, const ICoordinateSystem& csyGeom, const SPGeometry& geometry, Raw objectid, std::vector<VertexPosition>& points,  std::vector<VertexIndex>& indices, Tesselation *tesselation=0);
+    /*!
+     * \brief simplify creates a version of a line or polygon geometry with less vertices, polygons keep their topology
+     * \param geometry the geometry to simplify
+     * \param tolerance maximum distance (in the units of the geometry) between the simplified and the original geometry
+     * \return the simplified geometry or an empty pointer if the geometry can't or needn't be simplified
+     */
+    static UPGeometry simplify(const SPGeometry& geometry, double tolerance);
 private:
-    static void getPolygonVertices(const ICoordinateSystem& csyRoot, const ICoordinateSystem& csyGeom, const Ilwis::UPGeometry &geometry, Raw objectid, std::vector<VertexPosition> &points, std::vector<VertexIndex> &indices);
-    static void getLineVertices(const ICoordinateSystem &csyRoot, const ICoordinateSystem& csyGeom, const Ilwis::UPGeometry &geometry, Raw objectid, std::vector<VertexPosition> &points, std::vector<VertexIndex> &indices);
-    static void getPointVertices(const ICoordinateSystem& csyRoot, const ICoordinateSystem& csyGeom, const UPGeometry &geometry, Raw objectid, std::vector<VertexPosition> &points, std::vector<VertexIndex> &indices);
-
-    static IlwisTesselator _tesselator;
+    static void getPolygonVertices(const ICoordinateSystem& csyRoot, const ICoordinateSystem& csyGeom, const Ilwis::SPGeometry &geometry, Raw objectid, std::vector<VertexPosition> &points, std::vector<VertexIndex> &indices, Tesselation *tesselation);
+    static void getLineVertices(const ICoordinateSystem &csyRoot, const ICoordinateSystem& csyGeom, const Ilwis::SPGeometry &geometry, Raw objectid, std::vector<VertexPosition> &points, std::vector<VertexIndex> &indices);
+    static void getPointVertices(const ICoordinateSystem& csyRoot, const ICoordinateSystem& csyGeom, const SPGeometry &geometry, Raw objectid, std::vector<VertexPosition> &points, std::vector<VertexIndex> &indices);
 };
 }
 }
@@ -0,0 +1,250 @@
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLTexture>
+#include "coverage.h"
+#include "raster.h"
+#include "coordinatesystem.h"
+#include "drawingcolor.h"
+#include "drawerfactory.h"
+#include "rootdrawer.h"
+#include "table.h"
+#include "range.h"
+#include "itemrange.h"
+#include "colorrange.h"
+#include "colorlookup.h"
+#include "representation.h"
+#include "attributevisualproperties.h"
+#include "rasterlayerdrawer.h"
+
+using namespace Ilwis;
+using namespace Geodrawer;
+
+REGISTER_DRAWER(RasterLayerDrawer)
+
+RasterLayerDrawer::RasterLayerDrawer(DrawerInterface *parentDrawer, RootDrawer *rootdrawer) : LayerDrawer("RasterLayerDrawer", parentDrawer, rootdrawer)
+{
+}
+
+RasterLayerDrawer::~RasterLayerDrawer()
+{
+    QObject::disconnect(_contextDestroyed);
+    clearTextures();
+}
+
+DrawerInterface *RasterLayerDrawer::create(DrawerInterface *parentDrawer, RootDrawer *rootdrawer)
+{
+    return new RasterLayerDrawer(parentDrawer, rootdrawer)    ;
+}
+
+bool RasterLayerDrawer::prepare(DrawerInterface::PreparationType prepType, const IOOptions &options, QOpenGLContext *openglContext)
+{
+    if(!LayerDrawer::prepare(prepType, options, openglContext))
+        return false;
+
+    if(!initTextureShaders())
+        return false;
+
+    if ( hasType(prepType, DrawerInterface::ptGEOMETRY) && !isPrepared(DrawerInterface::ptGEOMETRY)){
+        IRasterCoverage raster = coverage().as<RasterCoverage>();
+        if ( !raster.isValid()){
+            return ERROR2(ERR_COULDNT_CREATE_OBJECT_FOR_2,"RasterCoverage", TR("Visualization"));
+        }
+        // the textures are only valid for the previous colors
+        clearTextures();
+        AttributeVisualProperties attr = visualAttribute(activeAttribute());
+        _renderer.raster(raster);
+        _renderer.colorTable(attr.colorTable());
+
+        _prepared |= DrawerInterface::ptGEOMETRY;
+    }
+    return true;
+}
+
+void RasterLayerDrawer::unprepare(DrawerInterface::PreparationType prepType)
+{
+    LayerDrawer::unprepare(prepType);
+
+    if ( hasType(prepType, DrawerInterface::ptGEOMETRY))    {
+        clearTextures();
+        _prepared &= ~ ptGEOMETRY;
+    }
+}
+
+void RasterLayerDrawer::setActiveVisualAttribute(const QString &attr)
+{
+    if ( attr == PIXELVALUE)
+        LayerDrawer::setActiveVisualAttribute(attr);
+}
+
+void RasterLayerDrawer::coverage(const ICoverage &cov)
+{
+    LayerDrawer::coverage(cov);
+    IRasterCoverage raster = coverage().as<RasterCoverage>();
+    if ( !raster.isValid())
+        return;
+
+    IlwisTypes attrType = raster->datadef().domain()->ilwisType();
+    AttributeVisualProperties props(raster->datadef().domain());
+    if ( attrType == itNUMERICDOMAIN){
+        SPNumericRange numrange = raster->datadef().range<NumericRange>();
+        props.actualRange(NumericRange(numrange->min(), numrange->max(), numrange->resolution()));
+    } else if ( attrType == itITEMDOMAIN){
+        int count = raster->datadef().domain()->range<>()->count();
+        props.actualRange(NumericRange(0, count - 1,1));
+    }
+    visualAttribute(PIXELVALUE, props);
+    setActiveVisualAttribute(PIXELVALUE);
+}
+
+ICoverage RasterLayerDrawer::coverage() const
+{
+    return SpatialDataDrawer::coverage();
+}
+
+bool RasterLayerDrawer::initTextureShaders()
+{
+    if ( _textureShaders.shaders().size() == 0){
+        _textureShaders.addShaderFromSourceCode(QOpenGLShader::Vertex,
+                                         "attribute highp vec4 position;"
+                                         "attribute highp vec2 texCoord;"
+                                         "uniform mat4 mvp;"
+                                         "varying highp vec2 fragmentTexCoord;"
+                                         "void main() {"
+                                         "    gl_Position =  mvp * position;"
+                                         "    fragmentTexCoord = texCoord;"
+                                         "}");
+        _textureShaders.addShaderFromSourceCode(QOpenGLShader::Fragment,
+                                         "uniform sampler2D tile;"
+                                         "varying highp vec2 fragmentTexCoord;"
+                                         "void main() {"
+                                         "    gl_FragColor = texture2D(tile, fragmentTexCoord);"
+                                         "}");
+        if(!_textureShaders.link()){
+            return ERROR2(QString("%1 : %2"),TR("Drawing failed"),TR(_textureShaders.log()));
+        }
+    }
+    return true;
+}
+
+QOpenGLTexture *RasterLayerDrawer::texture(const TileKey &key)
+{
+    auto iter = _textures.find(key);
+    if ( iter != _textures.end()){
+        _recentTextures.splice(_recentTextures.begin(), _recentTextures, (*iter).second.second);
+        return (*iter).second.first;
+    }
+    if ( _textures.size() >= MAXTEXTURES){
+        auto last = _textures.find(_recentTextures.back());
+        delete (*last).second.first;
+        _textures.erase(last);
+        _recentTextures.pop_back();
+    }
+    QOpenGLTexture *tex = new QOpenGLTexture(_renderer.tile(key)); // note: the image is mirrored, row 0 of the tile is at t = 1
+    tex->setMinificationFilter(QOpenGLTexture::Nearest);
+    tex->setMagnificationFilter(QOpenGLTexture::Nearest);
+    tex->setWrapMode(QOpenGLTexture::ClampToEdge);
+    _recentTextures.push_front(key);
+    _textures[key] = {tex, _recentTextures.begin()};
+    return tex;
+}
+
+void RasterLayerDrawer::textureContext(QOpenGLContext *openglContext)
+{
+    if ( _textureContext == openglContext)
+        return;
+    // textures of another context can't be used with this one
+    clearTextures();
+    QObject::disconnect(_contextDestroyed);
+    _textureContext = openglContext;
+    // the textures must be freed before their context goes, else they are left on the graphics card
+    _contextDestroyed = QObject::connect(openglContext, &QOpenGLContext::aboutToBeDestroyed, [this](){ clearTextures(); });
+}
+
+void RasterLayerDrawer::clearTextures()
+{
+    if ( _textures.size() == 0)
+        return;
+
+    // a QOpenGLTexture can only free its texture while its context (or one sharing with it) is current;
+    // the destructor and unprepare may run without it, so it is made current here and the previous context restored after
+    QOpenGLContext *current = QOpenGLContext::currentContext();
+    QSurface *currentSurface = current ? current->surface() : 0;
+    bool switched = false;
+    if ( _textureContext && _textureContext->surface() && (current == 0 || !QOpenGLContext::areSharing(current, _textureContext)))
+        switched = _textureContext->makeCurrent(_textureContext->surface());
+
+    for(auto& entry : _textures)
+        delete entry.second.first;
+    _textures.clear();
+    _recentTextures.clear();
+
+    if ( switched) {
+        if ( current && currentSurface)
+            current->makeCurrent(currentSurface);
+        else
+            _textureContext->doneCurrent();
+    }
+}
+
+bool RasterLayerDrawer::draw(QOpenGLContext *openglContext, const IOOptions &)
+{
+    if ( !openglContext){
+        return ERROR2(QString("%1 : %2"),TR("Drawing failed"),TR("Invalid OpenGL context passed"));
+    }
+    if ( !isActive())
+        return false;
+
+    if (!isPrepared()){
+        return false;
+    }
+    textureContext(openglContext);
+    IRasterCoverage raster = coverage().as<RasterCoverage>();
+    const IGeoReference& grf = raster->georeference();
+    Size<> screen = rootDrawer()->pixelAreaSize();
+    if ( !grf.isValid() || !screen.isValid() || screen.xsize() == 0)
+        return false;
+
+    // the part of the raster in view and the level of the tiles that fits the screen resolution
+    Envelope view = rootDrawer()->zoomEnvelope();
+    bool conversionNeeded = rootDrawer()->coordinateSystem() != raster->coordinateSystem();
+    if ( conversionNeeded)
+        view = raster->coordinateSystem()->convertEnvelope(rootDrawer()->coordinateSystem(), view);
+    BoundingBox area = grf->coord2Pixel(view);
+    quint32 level = _renderer.level(area.xlength() / screen.xsize());
+
+    _textureShaders.bind();
+    _textureShaders.setUniformValue("mvp", rootDrawer()->mvpMatrix());
+    _textureShaders.setUniformValue("tile", 0);
+    int vertexLocation = _textureShaders.attributeLocation("position");
+    int texLocation = _textureShaders.attributeLocation("texCoord");
+    _textureShaders.enableAttributeArray(vertexLocation);
+    _textureShaders.enableAttributeArray(texLocation);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    static const GLfloat texCoords[] = { 0,1, 1,1, 0,0, 1,0};
+    for(const TileKey& key : _renderer.tiles(area, level)){
+        BoundingBox tileBox = _renderer.tileArea(key);
+        // pixel corners of the tile; pixel (x,y) has its center at x + 0.5, y + 0.5
+        Coordinate corners[4] = {grf->pixel2Coord(Pixeld(tileBox.min_corner().x, tileBox.min_corner().y)),
+                                 grf->pixel2Coord(Pixeld(tileBox.max_corner().x + 1, tileBox.min_corner().y)),
+                                 grf->pixel2Coord(Pixeld(tileBox.min_corner().x, tileBox.max_corner().y + 1)),
+                                 grf->pixel2Coord(Pixeld(tileBox.max_corner().x + 1, tileBox.max_corner().y + 1))};
+        GLfloat positions[12];
+        for(int i = 0; i < 4; ++i){
+            Coordinate crd = conversionNeeded ? rootDrawer()->coordinateSystem()->coord2coord(raster->coordinateSystem(), corners[i]) : corners[i];
+            positions[i * 3] = crd.x;
+            positions[i * 3 + 1] = crd.y;
+            positions[i * 3 + 2] = 0;
+        }
+        texture(key)->bind(0);
+        _textureShaders.setAttributeArray(vertexLocation, positions, 3);
+        _textureShaders.setAttributeArray(texLocation, texCoords, 2);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    }
+
+    _textureShaders.disableAttributeArray(texLocation);
+    _textureShaders.disableAttributeArray(vertexLocation);
+    _textureShaders.release();
+
+    return true;
+}
@@ -0,0 +1,59 @@
+#ifndef RASTERLAYERDRAWER_H
+#define RASTERLAYERDRAWER_H
+
+#include <QPointer>
+#include <QtGui/QOpenGLContext>
+#include "layerdrawer.h"
+#include "rastertilerenderer.h"
+
+class QOpenGLTexture;
+
+#define PIXELVALUE "pixel_value"
+
+namespace Ilwis {
+namespace Geodrawer{
+
+/*!
+ * \brief The RasterLayerDrawer class draws a raster coverage as textured tiles
+ *
+ * The tiles are made by a RasterTileRenderer at the level that fits the current zoom; only the tiles that intersect the view are drawn.
+ * The textures of the most recently drawn tiles are kept on the graphics card. They belong to the context they were drawn with;
+ * that context is made current when they are released.
+ */
+class RasterLayerDrawer : public LayerDrawer
+{
+public:
+    RasterLayerDrawer(DrawerInterface* parentDrawer, RootDrawer *rootdrawer);
+    ~RasterLayerDrawer();
+
+    bool prepare(PreparationType prepType, const IOOptions& options,QOpenGLContext *openglContext=0);
+    void unprepare(DrawerInterface::PreparationType prepType);
+
+    void setActiveVisualAttribute(const QString& attr);
+    void coverage(const ICoverage &cov);
+    ICoverage coverage() const;
+
+    static DrawerInterface *create(DrawerInterface *parentDrawer, RootDrawer *rootdrawer);
+
+    NEW_DRAWER
+
+private:
+    static const quint32 MAXTEXTURES = 128;
+
+    RasterTileRenderer _renderer;
+    std::list<TileKey> _recentTextures; // most recently used texture at the front
+    std::map<TileKey, std::pair<QOpenGLTexture *, std::list<TileKey>::iterator>> _textures;
+    QOpenGLShaderProgram _textureShaders;
+    QPointer<QOpenGLContext> _textureContext;
+    QMetaObject::Connection _contextDestroyed;
+
+    bool draw(QOpenGLContext *openglContext, const IOOptions &options);
+    bool initTextureShaders();
+    QOpenGLTexture *texture(const TileKey& key);
+    void textureContext(QOpenGLContext *openglContext);
+    void clearTextures();
+};
+}
+}
+
+#endif // RASTERLAYERDRAWER_H
@@ -0,0 +1,162 @@
+#include <QPainter>
+#include "kernel.h"
+#include "ilwisdata.h"
+#include "raster.h"
+#include "rastertilerenderer.h"
+
+using namespace Ilwis;
+using namespace Geodrawer;
+
+RasterTileRenderer::RasterTileRenderer()
+{
+}
+
+void RasterTileRenderer::raster(const IRasterCoverage &raster, quint32 band)
+{
+    _raster = raster;
+    _band = band;
+    // once per raster (i.e. per preparation of the drawer); the tiles request overviews far more often
+    if ( _raster.isValid())
+        _raster->updateOverviews();
+    clear();
+}
+
+void RasterTileRenderer::colorTable(const ColorTable &table)
+{
+    _colorTable = table;
+    clear();
+}
+
+void RasterTileRenderer::clear()
+{
+    _tiles.clear();
+    _recentTiles.clear();
+}
+
+quint32 RasterTileRenderer::maxLevel() const
+{
+    if ( !_raster.isValid())
+        return 0;
+    Size<> sz = _raster->size();
+    quint32 level = 0;
+    while( (TILESIZE << level) < std::max(sz.xsize(), sz.ysize()))
+        ++level;
+    return level;
+}
+
+quint32 RasterTileRenderer::level(double rasterPixelsPerImagePixel) const
+{
+    quint32 level = 0;
+    while( level < maxLevel() && (1 << (level + 1)) <= rasterPixelsPerImagePixel)
+        ++level;
+    return level;
+}
+
+std::vector<TileKey> RasterTileRenderer::tiles(const BoundingBox &area, quint32 level) const
+{
+    std::vector<TileKey> keys;
+    if ( !_raster.isValid())
+        return keys;
+    Size<> sz = _raster->size();
+    qint32 minx = std::max(0, area.min_corner().x);
+    qint32 miny = std::max(0, area.min_corner().y);
+    qint32 maxx = std::min((qint32)sz.xsize() - 1, area.max_corner().x);
+    qint32 maxy = std::min((qint32)sz.ysize() - 1, area.max_corner().y);
+    if ( minx > maxx || miny > maxy)
+        return keys;
+    quint32 tileSpan = TILESIZE << level; // raster pixels covered by a tile
+    for(quint32 ty = miny / tileSpan; ty <= maxy / tileSpan; ++ty)
+        for(quint32 tx = minx / tileSpan; tx <= maxx / tileSpan; ++tx)
+            keys.push_back(TileKey(level, tx, ty));
+    return keys;
+}
+
+BoundingBox RasterTileRenderer::tileArea(const TileKey &key) const
+{
+    qint32 tileSpan = TILESIZE << key._level;
+    Pixel minCorner(key._x * tileSpan, key._y * tileSpan);
+    Pixel maxCorner(minCorner.x + tileSpan - 1, minCorner.y + tileSpan - 1);
+    return BoundingBox(minCorner, maxCorner);
+}
+
+const QImage &RasterTileRenderer::tile(const TileKey &key)
+{
+    auto iter = _tiles.find(key);
+    if ( iter != _tiles.end()){
+        _recentTiles.splice(_recentTiles.begin(), _recentTiles, (*iter).second.second);
+        return (*iter).second.first;
+    }
+    if ( _tiles.size() >= MAXTILES){
+        _tiles.erase(_recentTiles.back());
+        _recentTiles.pop_back();
+    }
+    _recentTiles.push_front(key);
+    auto& entry = _tiles[key];
+    entry.first = renderTile(key);
+    entry.second = _recentTiles.begin();
+    return entry.first;
+}
+
+QImage RasterTileRenderer::renderTile(const TileKey &key) const
+{
+    QImage image(TILESIZE, TILESIZE, QImage::Format_ARGB32);
+    image.fill(Qt::transparent);
+    if ( !_raster.isValid() || !_colorTable.isValid())
+        return image;
+
+    // the closest overview that isn't coarser than the level is sampled; its pixels cover 2^overviewLevel raster pixels
+    quint32 overviewLevel = std::min(key._level, _raster->overviewLevels());
+    IRasterCoverage source = overviewLevel > 0 ? _raster->overview(overviewLevel) : _raster;
+    if ( !source.isValid()){
+        source = _raster;
+        overviewLevel = 0;
+    }
+    Size<> sz = source->size();
+    const UPGrid& grid = source->gridRef();
+    qint32 step = 1 << (key._level - overviewLevel);
+    BoundingBox area = tileArea(key);
+    qint32 xstart = area.min_corner().x >> overviewLevel;
+    qint32 ystart = area.min_corner().y >> overviewLevel;
+    std::vector<double> values(TILESIZE);
+    for(quint32 row = 0; row < TILESIZE; ++row){
+        // the value at the center of the pixels covered by an image pixel represents them
+        qint32 y = ystart + row * step + step / 2;
+        if ( y >= sz.ysize())
+            y = ystart + row * step;
+        if ( y >= sz.ysize())
+            break;
+        quint32 columns = 0;
+        for(; columns < TILESIZE; ++columns){
+            qint32 x = xstart + columns * step + step / 2;
+            if ( x >= sz.xsize())
+                x = xstart + columns * step;
+            if ( x >= sz.xsize())
+                break;
+            values[columns] = grid->value(Pixel(x, y, _band));
+        }
+        _colorTable.values2rgba(values.data(), columns, (QRgb *)image.scanLine(row));
+    }
+    return image;
+}
+
+QImage RasterTileRenderer::render(const BoundingBox &area, const Size<> &imageSize)
+{
+    QImage image(imageSize.xsize(), imageSize.ysize(), QImage::Format_ARGB32);
+    image.fill(Qt::transparent);
+    if ( !_raster.isValid() || imageSize.xsize() == 0 || imageSize.ysize() == 0)
+        return image;
+
+    double scalex = (double)imageSize.xsize() / area.xlength();
+    double scaley = (double)imageSize.ysize() / area.ylength();
+    quint32 lvl = level(1.0 / std::max(scalex, scaley));
+    QPainter painter(&image);
+    for(const TileKey& key : tiles(area, lvl)){
+        BoundingBox tileBox = tileArea(key);
+        QRectF target((tileBox.min_corner().x - area.min_corner().x) * scalex,
+                      (tileBox.min_corner().y - area.min_corner().y) * scaley,
+                      tileBox.xlength() * scalex,
+                      tileBox.ylength() * scaley);
+        painter.drawImage(target, tile(key));
+    }
+    return image;
+}
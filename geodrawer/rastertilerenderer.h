@@ -0,0 +1,87 @@
+#ifndef RASTERTILERENDERER_H
+#define RASTERTILERENDERER_H
+
+#include <list>
+#include <map>
+#include <QImage>
+#include "colortable.h"
+
+namespace Ilwis {
+
+class RasterCoverage;
+typedef IlwisData<RasterCoverage> IRasterCoverage;
+
+namespace Geodrawer{
+
+struct TileKey {
+    TileKey(quint32 level=0, quint32 x=0, quint32 y=0) : _level(level), _x(x), _y(y) {}
+    quint32 _level;
+    quint32 _x;
+    quint32 _y;
+
+    bool operator<(const TileKey& key) const{
+        if ( _level != key._level)
+            return _level < key._level;
+        if ( _y != key._y)
+            return _y < key._y;
+        return _x < key._x;
+    }
+};
+
+/*!
+ * \brief The RasterTileRenderer class renders a band of a raster coverage into rgba tiles on the cpu
+ *
+ * A tile has TILESIZE x TILESIZE image pixels. At level n one image pixel covers 2^n x 2^n raster pixels, so the number of raster values
+ * read to fill a view depends on the size of the view and not on the size of the raster. Tiles are sampled from the overviews of the raster when it has them. Values are mapped to colors through a compiled
+ * ColorTable. Rendered tiles are kept in a least recently used cache. The renderer doesn't use OpenGL; render() composes a view into a
+ * QImage so the whole pipeline can be used (and tested) offscreen.
+ */
+class RasterTileRenderer
+{
+public:
+    static const quint32 TILESIZE = 256;
+    static const quint32 MAXTILES = 256;
+
+    RasterTileRenderer();
+
+    /*!
+     * \brief raster sets the raster to render and brings its overviews up to date with its changed blocks
+     */
+    void raster(const IRasterCoverage& raster, quint32 band=0);
+    void colorTable(const ColorTable& table);
+    void clear();
+
+    /*!
+     * \brief level the coarsest level at which an image pixel is not larger than the given number of raster pixels
+     * \param rasterPixelsPerImagePixel number of raster pixels covered by one pixel of the output (screen)
+     */
+    quint32 level(double rasterPixelsPerImagePixel) const;
+    quint32 maxLevel() const;
+    /*!
+     * \brief tiles the tiles at a level that are needed to cover an area of the raster
+     * \param area area in raster pixels, it is clipped to the raster
+     */
+    std::vector<TileKey> tiles(const BoundingBox& area, quint32 level) const;
+    /*!
+     * \brief tileArea the area (in raster pixels) covered by a tile; at the right and bottom edges of the raster this may extend beyond the raster
+     */
+    BoundingBox tileArea(const TileKey& key) const;
+    const QImage& tile(const TileKey& key);
+    /*!
+     * \brief render renders an area of the raster into an image of the given size
+     */
+    QImage render(const BoundingBox& area, const Size<>& imageSize);
+
+private:
+    QImage renderTile(const TileKey& key) const;
+
+    IRasterCoverage _raster;
+    quint32 _band = 0;
+    ColorTable _colorTable;
+    std::list<TileKey> _recentTiles; // most recently used tile at the front
+    std::map<TileKey, std::pair<QImage, std::list<TileKey>::iterator>> _tiles;
+};
+}
+}
+
+#endif // RASTERTILERENDERER_H
@@ -48,6 +48,11 @@ Envelope RootDrawer::viewEnvelope() const
     return _viewRect;
 }
 
+Envelope RootDrawer::zoomEnvelope() const
+{
+    return _zoomRect;
+}
+
 void RootDrawer::envelopeView(const Envelope &viewRect, bool overrule)
 {
     if ( !_coverageRect.isValid() || _coverageRect.isNull()){
@@ -137,6 +142,13 @@ Size<> RootDrawer::pixelAreaSize() const
     return _pixelAreaSize;
 }
 
+double RootDrawer::pixelSize() const
+{
+    if ( !_pixelAreaSize.isValid() || _pixelAreaSize.xsize() == 0 || _zoomRect.isNull())
+        return rUNDEF;
+    return _zoomRect.xlength() / _pixelAreaSize.xsize();
+}
+
 void RootDrawer::modifyEnvelopeZoomView(double dview, double dzoom, double ratio) {
     double deltaview = dview - dview * ratio ;
     double deltazoom = dzoom - dzoom * ratio;
@@ -25,9 +25,15 @@ public:
     void addEnvelope(const ICoordinateSystem& csSource, const Envelope& env, bool overrule);
 
     Envelope viewEnvelope() const;
+    Envelope zoomEnvelope() const;
     void envelopeView(const Envelope& viewRect, bool overrule);
     void pixelAreaSize(const Size<> &size);
     Size<> pixelAreaSize() const;
+    /*!
+     * \brief pixelSize size of one screen pixel in the units of the coordinate system of the rootdrawer at the current zoom level
+     * \return the size or rUNDEF if the view hasn't been set up yet
+     */
+    double pixelSize() const;
     const QMatrix4x4& mvpMatrix() const;
     const ICoordinateSystem& coordinateSystem() const;
     void coordinateSystem(const ICoordinateSystem& csy);
@@ -28,6 +28,7 @@ DEFINES += ILWISSCRIPT_LIBRARY
 SOURCES += \
     ilwisscript/ilwisscriptmodule.cpp \
     ilwisscript/script.cpp \
+    ilwisscript/scriptcache.cpp \
     ilwisscript/ast/astnode.cpp \
     ilwisscript/parserlexer/IlwisScriptLexer.cpp \
     ilwisscript/parserlexer/IlwisScriptParser.cpp \
@@ -63,6 +64,7 @@ HEADERS +=\
     ilwisscript/ilwisscriptmodule.h \
     ilwisscript/calculator_global.h \
     ilwisscript/script.h \
+    ilwisscript/scriptcache.h \
     ilwisscript/parserlexer/IlwisScriptParser.h \
     ilwisscript/parserlexer/IlwisScriptLexer.h \
     ilwisscript/parserlexer/IlwisScript.g \
@@ -41,6 +41,11 @@ bool AddNode::evaluate(SymbolTable &symbols, int scope, ExecutionContext *ctx)
 }
 
 bool AddNode::handleAdd(int index, const NodeValue& vright,SymbolTable &symbols, ExecutionContext *ctx) {
+    double left, right;
+    if ( SymbolTable::asNumber(vright[index], right) && resolveNumber(index, _value, symbols, left)) {
+       _value = {right + left, NodeValue::ctNumerical};
+       return true;
+    }
     QVariant var = resolveValue(index, _value, symbols);
     if ( SymbolTable::isNumerical(vright[index]) && SymbolTable::isNumerical(var)) {
        _value = {vright.toDouble(index) + var.toDouble(), NodeValue::ctNumerical};
@@ -61,6 +66,11 @@ bool AddNode::handleAdd(int index, const NodeValue& vright,SymbolTable &symbols,
 }
 
 bool AddNode::handleSubstract(int index, const NodeValue& vright,SymbolTable &symbols, ExecutionContext *ctx) {
+    double left, right;
+    if ( SymbolTable::asNumber(vright[index], right) && resolveNumber(index, _value, symbols, left)) {
+       _value = {left - right, NodeValue::ctNumerical};
+       return true;
+    }
     QVariant var = resolveValue(index, _value, symbols);
     if ( SymbolTable::isNumerical(vright[index]) && SymbolTable::isNumerical(var)) {
        _value = {var.toDouble() -  vright.toDouble(index), NodeValue::ctNumerical};
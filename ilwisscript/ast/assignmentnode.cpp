@@ -178,4 +178,20 @@ void AssignmentNode::setOutId(IDNode *idnode)
 
 }
 
+bool AssignmentNode::dataflow(std::set<QString> &reads, std::set<QString> &writes) const
+{
+    if ( _expression.isNull() || _outParms.isNull() || _outParms->hasModifiers())
+        return false;
+    _expression->identifiers(reads);
+    _outParms->identifiers(writes);
+    return true;
+}
 
+void AssignmentNode::subNodes(std::vector<ASTNode *> &nodes) const
+{
+    if ( !_expression.isNull())
+        nodes.push_back(_expression.data());
+    if ( !_outParms.isNull())
+        nodes.push_back(_outParms.data());
+    ASTNode::subNodes(nodes);
+}
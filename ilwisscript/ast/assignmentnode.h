@@ -19,6 +19,15 @@ public:
     bool evaluate(SymbolTable &symbols, int scope, ExecutionContext *ctx);
     void addOutputs(OutParametersNode *p);
     void setOutId(IDNode *idnode);
+    /*!
+     \brief gives the names read and written by this assignment
+
+     \param reads names the expression may read
+     \param writes names of the results
+     \return false if the assignment modifies or stores existing data (selectors, format specifiers) and may not be reordered
+     */
+    bool dataflow(std::set<QString>& reads, std::set<QString>& writes) const;
+    void subNodes(std::vector<ASTNode *>& nodes) const;
 private:
     template<typename T1> bool copyObject(const Symbol& sym, const QString& name,SymbolTable &symbols, bool useMerge=false) {
         IlwisData<T1> source =  sym._var.value<IlwisData<T1>>();
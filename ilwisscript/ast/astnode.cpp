@@ -37,6 +37,7 @@ NodeValue& NodeValue::operator=(const NodeValue& a) {
     _content = a._content;
     for(auto id : a._ids)
         _ids.push_back(id);
+    _slots = a._slots;
     return *this;
 }
 void NodeValue::setContentType(ContentType tp) {
@@ -122,6 +123,20 @@ QString NodeValue::toString(int index) const
     return sUNDEF;
 }
 
+qint32 NodeValue::slot(int index) const
+{
+    if ( index < _slots.size())
+        return _slots[index];
+    return -1;
+}
+
+void NodeValue::setSlot(int index, qint32 slot)
+{
+    if ( index >= _slots.size())
+        _slots.resize(index + 1, -1);
+    _slots[index] = slot;
+}
+
 QVariant NodeValue::value(int index) const
 {
     if ( index < size()) {
@@ -151,6 +166,38 @@ bool ASTNode::evaluate(SymbolTable& symbols, int scope, ExecutionContext* ctx)
     return true;
 }
 
+void ASTNode::identifiers(std::set<QString> &ids) const
+{
+    std::vector<ASTNode *> nodes;
+    subNodes(nodes);
+    for(ASTNode *node : nodes)
+        node->identifiers(ids);
+}
+
+void ASTNode::subNodes(std::vector<ASTNode *> &nodes) const
+{
+    for(const QSharedPointer<ASTNode>& node : _childeren)
+        nodes.push_back(node.data());
+}
+
+void ASTNode::clearValues()
+{
+    _value = NodeValue();
+    std::vector<ASTNode *> nodes;
+    subNodes(nodes);
+    for(ASTNode *node : nodes)
+        node->clearValues();
+}
+
+void ASTNode::resetState()
+{
+    _value = NodeValue();
+    std::vector<ASTNode *> nodes;
+    subNodes(nodes);
+    for(ASTNode *node : nodes)
+        node->resetState();
+}
+
 NodeValue ASTNode::value() const
 {
     return _value;
@@ -181,10 +228,10 @@ QVariant ASTNode::resolveValue(int index, const NodeValue &val, SymbolTable &sym
 
     QVariant var = val[index];
     if ( val.content() == NodeValue::ctID) {
-        Symbol sym = symbols.getSymbol(var.toString());
+        qint32 slot = val.slot(index);
+        Symbol sym = symbols.getSymbol(var.toString(), slot);
         if(sym.isValid()) {
-            QString tp = sym._var.typeName();
-            if ( tp == "QVariantList"){
+            if ( sym._var.userType() == QMetaType::QVariantList){
                 QVariantList lst = sym._var.value<QVariantList>();
                 var =  lst[0];
             }
@@ -194,3 +241,15 @@ QVariant ASTNode::resolveValue(int index, const NodeValue &val, SymbolTable &sym
     }
     return var;
 }
+
+bool ASTNode::resolveNumber(int index, const NodeValue &val, SymbolTable &symbols, double &number)
+{
+    if ( index>= val.size())
+        return false;
+
+    if ( val.content() == NodeValue::ctID) {
+        qint32 slot = val.slot(index);
+        return symbols.getNumber(val[index].toString(), slot, number);
+    }
+    return SymbolTable::asNumber(val[index], number);
+}
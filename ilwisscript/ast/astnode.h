@@ -4,6 +4,7 @@
 #include <QSharedPointer>
 #include <QVector>
 #include <QVariant>
+#include <set>
 
 namespace Ilwis {
 class SymbolTable;
@@ -31,10 +32,16 @@ public:
     int toInt(int index, bool *ok=0) const;
     QString toString(int index) const;
     QVariant value(int index=0) const;
+    /*!
+     \brief slot in the symbol table of the identifier at index, as found when the value was created; -1 if unknown. Only a hint, see SymbolTable::getSymbol
+     */
+    qint32 slot(int index) const;
+    void setSlot(int index, qint32 slot);
 
 private:
     NodeValue::ContentType _content;
     QList<QString> _ids;
+    std::vector<qint32> _slots;
 
 };
 class ASTNode
@@ -46,6 +53,26 @@ public:
    bool addChild(ASTNode *n);
    virtual bool evaluate(SymbolTable& symbols, int scope, ExecutionContext* ctx);
    virtual NodeValue value() const;
+   /*!
+    identifiers collects the names this node (and the nodes below it) may read from the symbol table or the catalog.
+    The collection is conservative; operation names and string literals are included as well. It is used to find
+    statements in a script that do not depend on each other.
+    */
+   virtual void identifiers(std::set<QString>& ids) const;
+   /*!
+    subNodes gives the direct descendants of this node, including those kept outside the generic child list
+    */
+   virtual void subNodes(std::vector<ASTNode *>& nodes) const;
+   /*!
+    clearValues drops the values computed by the last evaluation of this node and its descendants. Values may hold
+    references to (intermediate) objects which would otherwise stay alive as long as the syntax tree exists
+    */
+   void clearValues();
+   /*!
+    resetState brings this node and its descendants back to the state they had after parsing. A syntax tree that is reused for another
+    execution must not depend on symbols, files or the working catalog as they were found by an earlier one
+    */
+   virtual void resetState();
    bool isValid() const;
    int noOfChilderen() const;
    QSharedPointer<ASTNode> child(int i) const;
@@ -55,6 +82,11 @@ public:
 
 protected:
     QVariant resolveValue(int index, const NodeValue &value, SymbolTable& symbols);
+    /*!
+     resolveNumber as resolveValue, for values that are plain numbers; the number is not boxed in a QVariant.
+     False if the value is no plain number, resolveValue then gives the general answer
+     */
+    bool resolveNumber(int index, const NodeValue &value, SymbolTable& symbols, double& number);
     QVector<QSharedPointer<ASTNode> > _childeren;
     bool _evaluated;
     NodeValue _value;
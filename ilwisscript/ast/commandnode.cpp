@@ -28,3 +28,10 @@ void CommandNode::addOption(const QString &flag, ExpressionNode *expr)
 {
     _options[flag] = QSharedPointer<ExpressionNode>(expr);
 }
+
+void CommandNode::subNodes(std::vector<ASTNode *> &nodes) const
+{
+    for(const QSharedPointer<ExpressionNode>& node : _options)
+        nodes.push_back(node.data());
+    ASTNode::subNodes(nodes);
+}
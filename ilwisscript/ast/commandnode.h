@@ -9,6 +9,7 @@ public:
     QString nodeType() const;
     void setCommand(const QString& com);
     void addOption(const QString& flag, ExpressionNode *expr);
+    void subNodes(std::vector<ASTNode *>& nodes) const;
 
 private:
     QString _command;
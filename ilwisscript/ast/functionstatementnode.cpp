@@ -51,3 +51,10 @@ bool FunctionStatementNode::evaluate(SymbolTable &symbols, int scope, ExecutionC
     QString exp = QString("%1(%2)").arg(id()).arg(parm);
     return commandhandler()->execute(exp,ctx, symbols);
 }
+
+void FunctionStatementNode::subNodes(std::vector<ASTNode *> &nodes) const
+{
+    if ( !_parameters.isNull())
+        nodes.push_back(_parameters.data());
+    ASTNode::subNodes(nodes);
+}
@@ -10,6 +10,7 @@ public:
     QString nodeType() const;
 
     bool evaluate(SymbolTable &symbols, int scope, ExecutionContext *ctx);
+    void subNodes(std::vector<ASTNode *>& nodes) const;
 private:
     QSharedPointer<ParametersNode> _parameters;
 
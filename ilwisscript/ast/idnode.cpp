@@ -10,7 +10,7 @@
 
 using namespace Ilwis;
 
-IDNode::IDNode(char *name) : _text(name), _isreference(false)
+IDNode::IDNode(char *name) : _type(itUNKNOWN), _text(name), _isreference(false)
 {
 }
 
@@ -29,26 +29,33 @@ quint64 IDNode::type() const {
 }
 
 QString IDNode::id() const {
-    return _text;
+    return _resolved.isEmpty() ? _text : _resolved;
 }
 
 bool IDNode::isReference() const {
     return _isreference;
 }
 
+qint32 IDNode::slot() const {
+    return _slot;
+}
+
 
 bool IDNode::evaluate(SymbolTable& symbols, int scope, ExecutionContext *ctx) {
 
 
-    QVariant var = symbols.getValue(id(), scope);
-    if ( var.isValid()) {
+    // what the id refers to is determined again on every evaluation; only the slot is kept as a hint (e.g. in loops)
+    _isreference = false;
+    _resolved = "";
+    Symbol sym = symbols.getSymbol(_text, _slot, scope);
+    if ( sym.isValid() && sym._scope == scope) {
         _isreference = true;
         return true;
     }
 
-    _type = Ilwis::IlwisObject::findType(id());
+    _type = Ilwis::IlwisObject::findType(_text);
     if ( _type != itUNKNOWN){
-        _text = Ilwis::context()->workingCatalog()->resolve(_text);
+        _resolved = Ilwis::context()->workingCatalog()->resolve(_text);
         return true;
     }else {
         quint64 id = mastercatalog()->name2id(_text);
@@ -65,7 +72,7 @@ bool IDNode::evaluate(SymbolTable& symbols, int scope, ExecutionContext *ctx) {
 }
 
 IlwisTypes IDNode::tentativeFileType(const QString& ext) const{
-    QString name = id() + ext;
+    QString name = _text + ext;
     if ( !name.contains(QRegExp("\\\\|/"))) {
         name = Ilwis::context()->workingCatalog()->resolve(name);
     }
@@ -76,3 +83,17 @@ IlwisTypes IDNode::tentativeFileType(const QString& ext) const{
     return itUNKNOWN;
 
 }
+
+void IDNode::identifiers(std::set<QString> &ids) const
+{
+    ids.insert(_text);
+}
+
+void IDNode::resetState()
+{
+    ASTNode::resetState();
+    _type = itUNKNOWN;
+    _resolved = "";
+    _isreference = false;
+    _slot = -1;
+}
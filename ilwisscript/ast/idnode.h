@@ -21,14 +21,22 @@ public:
       \return bool true if the value can be found in the symbol table
     */
     bool isReference() const;
+    /*!
+     \brief slot of the identifier in the symbol table it was last evaluated against, -1 if it was not found there
+     */
+    qint32 slot() const;
     bool evaluate(SymbolTable &symbols, int scope, ExecutionContext *ctx);
+    void identifiers(std::set<QString>& ids) const;
+    void resetState();
 
 protected:
     IlwisTypes tentativeFileType(const QString &ext) const;
 
     quint64 _type;
-    QString _text;
+    QString _text; // as in the script, never changed by an evaluation
+    QString _resolved; // the location of the object the id refers to, if it was resolved in the working catalog
     bool _isreference;
+    qint32 _slot = -1;
 
 
 };
@@ -59,3 +59,14 @@ void Ifnode::addElse(ASTNode *node)
 {
      _else.push_back(QSharedPointer<ASTNode>(node));
 }
+
+void Ifnode::subNodes(std::vector<ASTNode *> &nodes) const
+{
+    if ( !_condition.isNull())
+        nodes.push_back(_condition.data());
+    for(const QSharedPointer<ASTNode>& node : _then)
+        nodes.push_back(node.data());
+    for(const QSharedPointer<ASTNode>& node : _else)
+        nodes.push_back(node.data());
+    ASTNode::subNodes(nodes);
+}
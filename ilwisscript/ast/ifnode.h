@@ -12,6 +12,7 @@ public:
     void setCondition(ExpressionNode *expr);
     void addThen(ASTNode *node);
     void addElse(ASTNode *node);
+    void subNodes(std::vector<ASTNode *>& nodes) const;
 
 private:
     QSharedPointer<ExpressionNode> _condition;
@@ -44,6 +44,11 @@ bool MultiplicationNode::evaluate(SymbolTable &symbols, int scope, ExecutionCont
 }
 
 bool MultiplicationNode::handleTimes(int index, const NodeValue& vright, SymbolTable &symbols, ExecutionContext *ctx) {
+    double left, right;
+    if ( SymbolTable::asNumber(vright[index], right) && resolveNumber(index, _value, symbols, left)) {
+        _value = {right * left, NodeValue::ctNumerical};
+        return true;
+    }
     QVariant var = resolveValue(index, _value, symbols);
     if ( SymbolTable::isNumerical(vright[index]) && SymbolTable::isNumerical(var)) {
         _value = {vright.toDouble(index) * var.toDouble(), NodeValue::ctNumerical};
@@ -58,6 +63,13 @@ bool MultiplicationNode::handleTimes(int index, const NodeValue& vright, SymbolT
 }
 
 bool MultiplicationNode::handleDiv(int index, const NodeValue& vright, SymbolTable &symbols, ExecutionContext *ctx) {
+    double left, right;
+    if ( SymbolTable::asNumber(vright[index], right) && resolveNumber(index, _value, symbols, left)) {
+        if ( right == 0)
+            return false;
+        _value = {left / right, NodeValue::ctNumerical};
+        return true;
+    }
     QVariant var = resolveValue( index, _value, symbols);
     if (SymbolTable:: isNumerical(vright[index]) && SymbolTable::isNumerical(var)) {
         if ( vright.toDouble(index) == 0)
@@ -56,6 +56,11 @@ bool OperationNode::handleBinaryCases(int index, const NodeValue& vright, const
     bool ok = Ilwis::commandhandler()->execute(expr, ctx,symbols);
     if ( !ok || ctx->_results.size() != 1)
         return false;
+    // operands that were intermediate results are not used anymore
+    for(const QString& operand : {_value.id(index), vright.id(index)}) {
+        if ( operand != ctx->_results[0])
+            symbols.releaseAnonymous(operand);
+    }
     _value = {ctx->_results[0], NodeValue::ctID};
     return true;
 }
@@ -107,4 +112,11 @@ QString OperationNode::additionalInfo(ExecutionContext *ctx, const QString& key
     return (*iter).second;
 }
 
-
+void OperationNode::subNodes(std::vector<ASTNode *> &nodes) const
+{
+    if ( !_leftTerm.isNull())
+        nodes.push_back(_leftTerm.data());
+    for(const RightTerm& term : _rightTerm)
+        nodes.push_back(term._rightTerm.data());
+    ASTNode::subNodes(nodes);
+}
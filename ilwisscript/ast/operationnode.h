@@ -17,6 +17,7 @@ public:
     void addRightTerm(OperationNode::Operators op, ASTNode *node);
     bool evaluate(SymbolTable& symbols, int scope, ExecutionContext *ctx);
     bool isValid() const;
+    void subNodes(std::vector<ASTNode *>& nodes) const;
 
 
 protected:
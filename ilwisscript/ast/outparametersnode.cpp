@@ -50,4 +50,24 @@ QSharedPointer<ASTNode> OutParametersNode::specifier(const QString& id) const
     return QSharedPointer<ASTNode>();
 }
 
+bool OutParametersNode::hasModifiers() const
+{
+    return _selectors.size() > 0 || _specifiers.size() > 0;
+}
 
+void OutParametersNode::identifiers(std::set<QString> &ids) const
+{
+    for(const QSharedPointer<IDNode>& node : _ids)
+        ids.insert(node->id());
+}
+
+void OutParametersNode::subNodes(std::vector<ASTNode *> &nodes) const
+{
+    for(const QSharedPointer<IDNode>& node : _ids)
+        nodes.push_back(node.data());
+    for(const auto& item : _selectors)
+        nodes.push_back(item.second.data());
+    for(const auto& item : _specifiers)
+        nodes.push_back(item.second.data());
+    ASTNode::subNodes(nodes);
+}
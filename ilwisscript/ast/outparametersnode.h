@@ -14,6 +14,12 @@ public:
     QSharedPointer<Selector> selector(const QString &id) const;
     QString id(int index) const;
     QSharedPointer<ASTNode> specifier(const QString &id) const;
+    /*!
+     \brief true if one of the results has a selector or format specifier, which means the assignment modifies or stores existing data
+     */
+    bool hasModifiers() const;
+    void identifiers(std::set<QString>& ids) const;
+    void subNodes(std::vector<ASTNode *>& nodes) const;
 
 private:
     std::vector<QSharedPointer<IDNode>> _ids;
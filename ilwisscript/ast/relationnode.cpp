@@ -50,7 +50,11 @@ bool RelationNode::evaluate(SymbolTable &symbols, int scope, ExecutionContext *c
 
 
 bool RelationNode::handleEQ(int index,const NodeValue& vright,SymbolTable &symbols, ExecutionContext *ctx) {
-
+    double left, right;
+    if ( !ctx->_useAdditionalParameters && resolveNumber(index, _value, symbols, left) && resolveNumber(index, vright, symbols, right)) {
+       _value = {left == right, NodeValue::ctBOOLEAN};
+       return true;
+    }
     QVariant var1 = resolveValue(index,_value,symbols);
     QVariant var2 = resolveValue(index, vright, symbols);
     if ( ctx->_useAdditionalParameters){
@@ -68,6 +72,11 @@ bool RelationNode::handleEQ(int index,const NodeValue& vright,SymbolTable &symbo
 }
 
 bool RelationNode::handleNEQ(int index,const NodeValue& vright,SymbolTable &symbols, ExecutionContext *ctx) {
+    double left, right;
+    if ( !ctx->_useAdditionalParameters && resolveNumber(index, _value, symbols, left) && resolveNumber(index, vright, symbols, right)) {
+       _value = {left != right, NodeValue::ctBOOLEAN};
+       return true;
+    }
     QVariant var1 = resolveValue(index, _value,symbols);
     QVariant var2 = resolveValue(index, vright, symbols);
     if ( ctx->_useAdditionalParameters){
@@ -85,6 +94,11 @@ bool RelationNode::handleNEQ(int index,const NodeValue& vright,SymbolTable &symb
 }
 
 bool RelationNode::handleGREATEREQ(int index,const NodeValue& vright,SymbolTable &symbols, ExecutionContext *ctx) {
+    double left, right;
+    if ( !ctx->_useAdditionalParameters && resolveNumber(index, _value, symbols, left) && resolveNumber(index, vright, symbols, right)) {
+       _value = {left >= right, NodeValue::ctBOOLEAN};
+       return true;
+    }
     QVariant var1 = resolveValue(index, _value,symbols);
     QVariant var2 = resolveValue(index, vright, symbols);
     if ( ctx->_useAdditionalParameters){
@@ -98,6 +112,11 @@ bool RelationNode::handleGREATEREQ(int index,const NodeValue& vright,SymbolTable
 }
 
 bool RelationNode::handleGREATER(int index,const NodeValue& vright,SymbolTable &symbols, ExecutionContext *ctx) {
+    double left, right;
+    if ( !ctx->_useAdditionalParameters && resolveNumber(index, _value, symbols, left) && resolveNumber(index, vright, symbols, right)) {
+       _value = {left > right, NodeValue::ctBOOLEAN};
+       return true;
+    }
     QVariant var1 = resolveValue(index, _value,symbols);
     QVariant var2 = resolveValue(index,vright, symbols);
     if ( ctx->_useAdditionalParameters){
@@ -111,6 +130,11 @@ bool RelationNode::handleGREATER(int index,const NodeValue& vright,SymbolTable &
 }
 
 bool RelationNode::handleLESS(int index,const NodeValue& vright,SymbolTable &symbols, ExecutionContext *ctx) {
+    double left, right;
+    if ( !ctx->_useAdditionalParameters && resolveNumber(index, _value, symbols, left) && resolveNumber(index, vright, symbols, right)) {
+       _value = {left < right, NodeValue::ctBOOLEAN};
+       return true;
+    }
     QVariant var1 = resolveValue(index, _value,symbols);
     QVariant var2 = resolveValue(index, vright, symbols);
     if ( ctx->_useAdditionalParameters){
@@ -124,6 +148,11 @@ bool RelationNode::handleLESS(int index,const NodeValue& vright,SymbolTable &sym
 }
 
 bool RelationNode::handleLESSEQ(int index,const NodeValue& vright,SymbolTable &symbols, ExecutionContext *ctx) {
+    double left, right;
+    if ( !ctx->_useAdditionalParameters && resolveNumber(index, _value, symbols, left) && resolveNumber(index, vright, symbols, right)) {
+       _value = {left <= right, NodeValue::ctBOOLEAN};
+       return true;
+    }
     QVariant var1 = resolveValue(index, _value,symbols);
     QVariant var2 = resolveValue(index, vright, symbols);
     if ( ctx->_useAdditionalParameters){
@@ -1,6 +1,7 @@
 #include <map>
 #include "ilwis.h"
 #include "symboltable.h"
+#include "commandhandler.h"
 #include "astnode.h"
 #include "idnode.h"
 #include "formatter.h"
@@ -19,6 +20,18 @@ QString ScriptLineNode::nodeType() const
 }
 
 bool ScriptLineNode::evaluate(SymbolTable &symbols, int scope, ExecutionContext *ctx )
+{
+    quint64 anonymStart = SymbolTable::anonymCount();
+    bool ok = evaluateStatement(symbols, scope, ctx);
+    // intermediate results can not be referenced by name in the script, so none of them lives beyond the statement that created them.
+    // The values in the tree and the anonymous symbols are the last references to them; releasing both frees their grids
+    clearValues();
+    releaseIntermediates(symbols, anonymStart, ctx->_results);
+
+    return ok;
+}
+
+bool ScriptLineNode::evaluateStatement(SymbolTable &symbols, int scope, ExecutionContext *ctx)
 {
      _evaluated = true;
     foreach(QSharedPointer<ASTNode> node, _childeren) {
@@ -33,10 +46,15 @@ bool ScriptLineNode::evaluate(SymbolTable &symbols, int scope, ExecutionContext
             break;
         }
     }
+    return _evaluated;
+}
+
+void ScriptLineNode::releaseIntermediates(SymbolTable &symbols, quint64 anonymStart, const std::vector<QString> &keep)
+{
+    symbols.releaseAnonymous(anonymStart, keep);
+
     // we do not keep al binary data in memory for rasters as within a script they might not get out of scope until
     // the script finishes. This quickly fills up memory. So we unload all binaries and the raster will reload when it
     // is needed (if it all). This means a slight performance hit but it is necessary
     symbols.unloadRasters();
-
-    return _evaluated;
 }
@@ -8,6 +8,16 @@ public:
     ScriptLineNode();
     QString nodeType() const;
     bool evaluate(SymbolTable &symbols, int scope, ExecutionContext *ctx);
+    /*!
+     evaluateStatement evaluates the statement on this line but keeps its intermediate results; evaluate() releases them directly afterwards.
+     Statements that are evaluated together (see ScriptNode) release the intermediate results of the whole group once they all have finished
+     */
+    bool evaluateStatement(SymbolTable &symbols, int scope, ExecutionContext *ctx);
+    /*!
+     releaseIntermediates removes the anonymous symbols created since anonymStart, except the results in keep, and unloads the raster data
+     held by the symbol table
+     */
+    static void releaseIntermediates(SymbolTable &symbols, quint64 anonymStart, const std::vector<QString> &keep);
 };
 }
 
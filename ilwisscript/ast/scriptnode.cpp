@@ -1,10 +1,20 @@
 #include <map>
-#include "ilwis.h"
+#include <algorithm>
+#include <future>
+#include <QThread>
+#include "kernel.h"
+#include "ilwisdata.h"
 #include "symboltable.h"
+#include "commandhandler.h"
+#include "mastercatalog.h"
+#include "ilwiscontext.h"
 #include "astnode.h"
 #include "idnode.h"
 #include "formatter.h"
 #include "scriptnode.h"
+#include "scriptlinenode.h"
+#include "outparametersnode.h"
+#include "assignmentnode.h"
 
 using namespace Ilwis;
 
@@ -19,6 +29,142 @@ QString ScriptNode::nodeType() const
     return "script";
 }
 
+bool ScriptNode::evaluate(SymbolTable &symbols, int scope, ExecutionContext *ctx)
+{
+    // off by default; the master catalog and the kernel database connection are not safe to use from the worker threads yet
+    if ( !ilwisconfig("system-settings/concurrent-script-statements", false))
+        return ASTNode::evaluate(symbols, scope, ctx);
+
+    // consecutive plain assignments are collected and evaluated as a dataflow graph; every other
+    // statement (control flow, commands, formatters, assignments with selectors or formats) is a barrier
+    std::vector<Statement> statements;
+    for(const QSharedPointer<ASTNode>& line : _childeren) {
+        Statement statement;
+        if ( isIndependent(line, statement)) {
+            statements.push_back(statement);
+            continue;
+        }
+        if (!evaluateConcurrent(statements, symbols, scope, ctx))
+            return false;
+        if (!line->evaluate(symbols, scope, ctx))
+            return false;
+    }
+    return evaluateConcurrent(statements, symbols, scope, ctx);
+}
+
+bool ScriptNode::isIndependent(const QSharedPointer<ASTNode>& line, Statement& statement) const
+{
+    if ( line->nodeType() != "scriptline" || line->noOfChilderen() != 1)
+        return false;
+    QSharedPointer<ASTNode> node = line->child(0);
+    if ( node->nodeType() != "assignment")
+        return false;
+    statement._line = static_cast<ScriptLineNode *>(line.data());
+    return static_cast<AssignmentNode *>(node.data())->dataflow(statement._reads, statement._writes);
+}
+
+bool ScriptNode::evaluateConcurrent(std::vector<Statement>& statements, SymbolTable &symbols, int scope, ExecutionContext *ctx)
+{
+    if ( statements.empty())
+        return true;
+
+    std::vector<Statement> current;
+    current.swap(statements);
+    quint64 anonymStart = SymbolTable::anonymCount();
+
+    auto intersects = [](const std::set<QString>& set1, const std::set<QString>& set2)->bool{
+        for(const QString& id : set1)
+            if ( set2.find(id) != set2.end())
+                return true;
+        return false;
+    };
+
+    // a statement is evaluated in the wave after the last statement it depends on; the statements within a wave are independent
+    std::vector<quint32> waves(current.size(), 0);
+    quint32 waveCount = 0;
+    for(quint32 i = 0; i < current.size(); ++i) {
+        for(quint32 j = 0; j < i; ++j) {
+            if ( intersects(current[j]._writes, current[i]._reads) ||
+                 intersects(current[j]._writes, current[i]._writes) ||
+                 intersects(current[j]._reads, current[i]._writes))
+                waves[i] = std::max(waves[i], waves[j] + 1);
+        }
+        waveCount = std::max(waveCount, waves[i] + 1);
+    }
+
+    // each statement gets its own context; the symbol table is shared and guards itself while the statements run
+    std::vector<ExecutionContext> contexts(current.size(), *ctx);
+    bool wasConcurrent = symbols.concurrent();
+    symbols.concurrent(true);
+    bool ok = true;
+    std::exception_ptr error;
+    for(quint32 wave = 0; wave < waveCount && ok; ++wave) {
+        std::vector<quint32> members;
+        for(quint32 i = 0; i < current.size(); ++i)
+            if ( waves[i] == wave)
+                members.push_back(i);
+        // as with the blocks of a raster operation, the statements are spread over at most one task per core
+        quint32 cores = std::min((quint32)std::max(1, QThread::idealThreadCount()), (quint32)members.size());
+        std::vector<std::future<bool>> futures(cores);
+        for(quint32 task = 0; task < cores; ++task) {
+            futures[task] = std::async(std::launch::async, [&current, &contexts, &members, &symbols, scope, task, cores]()->bool{
+                bool res = true;
+                for(quint32 m = task; m < members.size() && res; m += cores) {
+                    quint32 i = members[m];
+                    res = current[i]._line->evaluateStatement(symbols, scope, &contexts[i]);
+                }
+                return res;
+            });
+        }
+        for(std::future<bool>& result : futures) {
+            try {
+                ok = result.get() && ok;
+            } catch(...) {
+                if ( !error)
+                    error = std::current_exception();
+                ok = false;
+            }
+        }
+    }
+    symbols.concurrent(wasConcurrent);
+    // profiles of all statements are kept, each context started with the profiles already present in ctx
+    std::vector<OperationProfile> profiles = ctx->_profiles;
+    for(const ExecutionContext& localCtx : contexts)
+        profiles.insert(profiles.end(), localCtx._profiles.begin() + ctx->_profiles.size(), localCtx._profiles.end());
+    if ( ok)
+        *ctx = mergeContexts(*ctx, contexts);
+    ctx->_profiles = profiles;
+    // see ScriptLineNode::evaluate; done once for the whole group as other statements may still use the rasters
+    for(Statement& statement : current)
+        statement._line->clearValues();
+    ScriptLineNode::releaseIntermediates(symbols, anonymStart, ctx->_results);
+    if ( error)
+        std::rethrow_exception(error);
+
+    return ok;
+}
+
+ExecutionContext ScriptNode::mergeContexts(const ExecutionContext& start, const std::vector<ExecutionContext>& contexts) const
+{
+    // settings come from the last statement as they would when evaluated one after the other;
+    // results and additional info of all statements are kept, in statement order
+    ExecutionContext merged = contexts.back();
+    merged._results.clear();
+    merged._additionalInfo.clear();
+    for(const ExecutionContext& localCtx : contexts) {
+        for(const QString& result : localCtx._results)
+            if ( std::find(merged._results.begin(), merged._results.end(), result) == merged._results.end())
+                merged._results.push_back(result);
+        for(const auto& info : localCtx._additionalInfo)
+            merged._additionalInfo[info.first] = info.second;
+        if ( localCtx._masterGeoref != start._masterGeoref)
+            merged._masterGeoref = localCtx._masterGeoref;
+        if ( localCtx._masterCsy != start._masterCsy)
+            merged._masterCsy = localCtx._masterCsy;
+    }
+    return merged;
+}
+
 Formatter * ScriptNode::activeFormat(IlwisTypes type)
 {
     auto iter= _activeFormat.find(type);
@@ -6,16 +6,28 @@
 namespace Ilwis {
 
 class Formatter;
+class ScriptLineNode;
 
 class ScriptNode : public ASTNode
 {
 public:
     ScriptNode();
     QString nodeType() const;
+    bool evaluate(SymbolTable &symbols, int scope, ExecutionContext *ctx);
     static Formatter *activeFormat(IlwisTypes type);
     static void setActiveFormat(quint64, const QSharedPointer<ASTNode>& node);
 
 private:
+    struct Statement {
+        ScriptLineNode *_line;
+        std::set<QString> _reads;
+        std::set<QString> _writes;
+    };
+
+    bool isIndependent(const QSharedPointer<ASTNode> &line, Statement &statement) const;
+    bool evaluateConcurrent(std::vector<Statement> &statements, SymbolTable &symbols, int scope, ExecutionContext *ctx);
+    ExecutionContext mergeContexts(const ExecutionContext &start, const std::vector<ExecutionContext> &contexts) const;
+
     static std::map<quint64, QSharedPointer<ASTNode> > _activeFormat;
 };
 }
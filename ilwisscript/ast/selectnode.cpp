@@ -49,7 +49,15 @@ void SelectNode::setExpression(ExpressionNode *n)
     _expression = QSharedPointer<ExpressionNode>(n);
 }
 
+void SelectNode::identifiers(std::set<QString> &ids) const
+{
+    ids.insert(QString(_inputId).remove('\"'));
+    ASTNode::identifiers(ids);
+}
 
-
-
-
+void SelectNode::subNodes(std::vector<ASTNode *> &nodes) const
+{
+    if ( !_expression.isNull())
+        nodes.push_back(_expression.data());
+    ASTNode::subNodes(nodes);
+}
@@ -13,6 +13,8 @@ public:
 
     bool evaluate(SymbolTable &symbols, int scope, ExecutionContext *ctx);
     void setExpression(ExpressionNode *n);
+    void identifiers(std::set<QString>& ids) const;
+    void subNodes(std::vector<ASTNode *>& nodes) const;
 private:
     QString _inputId = sUNDEF;
     QSharedPointer<ExpressionNode> _expression;
@@ -123,12 +123,14 @@ bool TermNode::doMethodStatement(SymbolTable &symbols, int scope, ExecutionConte
             parms += (*iter).second;
         }
     }
+    std::vector<QString> names;
     for(int i=0; i < _parameters->noOfChilderen(); ++i) {
         bool ok = _parameters->child(i)->evaluate(symbols, scope, ctx);
 
         if (!ok)
             return false;
         QString name = getName(_parameters->child(i)->value());
+        names.push_back(name);
         if ( parms.size() > 1)
             parms += ",";
         parms += name;
@@ -140,6 +142,13 @@ bool TermNode::doMethodStatement(SymbolTable &symbols, int scope, ExecutionConte
     if ( !ok || ctx->_results.size() != 1)
         throw ScriptExecutionError(TR("Expression execution error in script; script aborted. See log for further details"));
 
+    // intermediate results passed as parameters have had their only use
+    _parameters->clearValues();
+    for(const QString& name : names) {
+        if ( name != ctx->_results[0])
+            symbols.releaseAnonymous(name);
+    }
+
     _value = {symbols.getValue(ctx->_results[0]), ctx->_results[0], NodeValue::ctMethod};
     return true;
 }
@@ -162,8 +171,9 @@ bool TermNode::doIDStatement(SymbolTable &symbols, int scope, ExecutionContext *
     _id->evaluate(symbols, scope, ctx);
     QString value;
 
+    qint32 slot = _id->slot();
     if ( _id->isReference()) {
-        if ( symbols.getSymbol(_id->id(),scope).isValid())
+        if ( symbols.getSymbol(_id->id(), slot, scope).isValid())
             value = _id->id();
         else
             return false;
@@ -182,6 +192,8 @@ bool TermNode::doIDStatement(SymbolTable &symbols, int scope, ExecutionContext *
 
 
     _value = {value, NodeValue::ctID};
+    if ( value == _id->id())
+        _value.setSlot(0, slot);
     return value != "" && value != sUNDEF;
 }
 
@@ -236,3 +248,23 @@ void TermNode::addSelector(Selector *n)
 {
     _selectors.push_back(QSharedPointer<Selector>(n));
 }
+
+void TermNode::identifiers(std::set<QString> &ids) const
+{
+    if ( _content == csString) {
+        // a string may name an object produced by an earlier statement
+        ids.insert(QString(_string).remove('\"'));
+    }
+    ASTNode::identifiers(ids);
+}
+
+void TermNode::subNodes(std::vector<ASTNode *> &nodes) const
+{
+    if ( !_expression.isNull())
+        nodes.push_back(_expression.data());
+    if ( !_id.isNull())
+        nodes.push_back(_id.data());
+    if ( !_parameters.isNull())
+        nodes.push_back(_parameters.data());
+    ASTNode::subNodes(nodes);
+}
@@ -16,6 +16,8 @@ public:
     void setNumericalNegation(bool yesno);
     bool evaluate(SymbolTable& symbols, int scope, ExecutionContext *ctx);
     void addSelector(Selector *n);
+    void identifiers(std::set<QString>& ids) const;
+    void subNodes(std::vector<ASTNode *>& nodes) const;
 
 private:
     enum ContentState{csNumerical, csString, csExpression, csMethod,csID};
@@ -48,3 +48,10 @@ bool WhileNode::evaluate(SymbolTable &symbols, int scope, ExecutionContext *ctx)
     }
     return true;
 }
+
+void WhileNode::subNodes(std::vector<ASTNode *> &nodes) const
+{
+    if ( !_condition.isNull())
+        nodes.push_back(_condition.data());
+    ASTNode::subNodes(nodes);
+}
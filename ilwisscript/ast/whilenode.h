@@ -11,6 +11,7 @@ public:
 
 
     bool evaluate(SymbolTable &symbols, int scope, ExecutionContext *ctx);
+    void subNodes(std::vector<ASTNode *>& nodes) const;
 private:
     QSharedPointer<ExpressionNode> _condition;
 
@@ -12,6 +12,8 @@
 #include "commandhandler.h"
 #include "operation.h"
 #include "script.h"
+#include "astnode.h"
+#include "scriptcache.h"
 #include "parserlexer/IlwisScriptLexer.h"
 #include "parserlexer/ilwisscriptParser.h"
 
@@ -103,37 +105,66 @@ bool Script::execute(ExecutionContext *ctx, SymbolTable& symbols )
         if((_prepState = prepare(ctx, symbols)) != sPREPARED)
             return false;
 
+    // a script that ran before is evaluated with its cached syntax tree; lexing and parsing are skipped
+    QByteArray key = ScriptCache::key(_buffer.get(), _bufferSize);
+    bool cacheable = true;
+    UPASTNode scr = ScriptCache::take(key);
+    if (!scr) {
+        scr.reset(parse(cacheable));
+        if (!scr)
+            return false;
+    }
+
+    bool ok = scr->evaluate(symbols, 1000, ctx);
+    if ( cacheable)
+        ScriptCache::giveBack(key, std::move(scr));
+    return ok;
+    }
+    catch(Ilwis::ScriptError& err) {
+        kernel()->issues()->log(err.message());
+    }
+    return false;
+
+}
+
+ASTNode *Script::parse(bool& cacheable) const
+{
     ANTLR3_UINT8 * bufferData = (ANTLR3_UINT8 *) _buffer.get();
 
     pANTLR3_INPUT_STREAM input = antlr3StringStreamNew(bufferData,  ANTLR3_ENC_8BIT,  _bufferSize, (pANTLR3_UINT8)"ScriptText");
     if(input == NULL)
-        return false;
+        return 0;
 
     pilwisscriptLexer lxr = ilwisscriptLexerNew(input);
-    if(lxr == NULL)
-        return false;
+    if(lxr == NULL) {
+        input->close(input);
+        return 0;
+    }
 
     //Creates an empty token stream.
     pANTLR3_COMMON_TOKEN_STREAM tstream = antlr3CommonTokenStreamSourceNew(ANTLR3_SIZE_HINT, TOKENSOURCE(lxr));
-    if(tstream == NULL)
-        return false;
+    if(tstream == NULL) {
+        lxr->free(lxr);
+        input->close(input);
+        return 0;
+    }
 
     //Creates a parser.
     pilwisscriptParser psr = ilwisscriptParserNew(tstream);
-    if(psr == NULL)
-        return false;
-
-    //Run the parser rule. This also runs the lexer to create the token stream.
-    ASTNode *scr = psr->script(psr);
-
-    bool ok = scr->evaluate(symbols, 1000, ctx);
-    return ok;
+    ASTNode *scr = 0;
+    if(psr != NULL) {
+        //Run the parser rule. This also runs the lexer to create the token stream.
+        scr = psr->script(psr);
+        // a tree built from a script with syntax errors is used once but never cached
+        cacheable = psr->pParser->rec->getNumberOfSyntaxErrors(psr->pParser->rec) == 0;
+        psr->free(psr);
     }
-    catch(Ilwis::ScriptError& err) {
-        kernel()->issues()->log(err.message());
-    }
-    return false;
+    // the tree holds copies of all token texts, so the antlr structures can go
+    tstream->free(tstream);
+    lxr->free(lxr);
+    input->close(input);
 
+    return scr;
 }
 
 quint64 Script::createMetadata()
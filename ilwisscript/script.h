@@ -3,6 +3,8 @@
 
 namespace Ilwis {
 
+class ASTNode;
+
 class Script : public OperationImplementation
 {
 public:
@@ -20,6 +22,7 @@ private:
     quint32 _bufferSize;
 
     bool detectKey(const std::string &line, const std::string &key);
+    ASTNode *parse(bool &cacheable) const;
 
 };
 }
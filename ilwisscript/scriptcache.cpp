@@ -0,0 +1,64 @@
+#include <QCryptographicHash>
+#include "kernel.h"
+#include "locker.h"
+#include "astnode.h"
+#include "scriptcache.h"
+
+using namespace Ilwis;
+
+std::mutex ScriptCache::_lock;
+std::map<QByteArray, std::list<UPASTNode>> ScriptCache::_idleTrees;
+std::list<QByteArray> ScriptCache::_usage;
+
+QByteArray ScriptCache::key(const char *text, quint32 size)
+{
+    return QCryptographicHash::hash(QByteArray::fromRawData(text, size), QCryptographicHash::Sha1);
+}
+
+UPASTNode ScriptCache::take(const QByteArray &key)
+{
+    UPASTNode tree;
+    {
+        Locker<std::mutex> lock(_lock);
+        auto iter = _idleTrees.find(key);
+        if ( iter == _idleTrees.end() || (*iter).second.empty())
+            return UPASTNode();
+
+        tree = std::move((*iter).second.front());
+        (*iter).second.pop_front();
+        _usage.remove(key);
+        _usage.push_front(key);
+    }
+    // nothing found by the previous execution (symbols, resolved files) may leak into this one
+    tree->resetState();
+    return tree;
+}
+
+void ScriptCache::giveBack(const QByteArray &key, UPASTNode tree)
+{
+    if (!tree)
+        return;
+
+    UPASTNode evicted; // deleted outside the lock
+    std::list<UPASTNode> evictedScript;
+    {
+        Locker<std::mutex> lock(_lock);
+        auto iter = _idleTrees.find(key);
+        if ( iter == _idleTrees.end()) {
+            if ( _idleTrees.size() >= MAXSCRIPTS && !_usage.empty()) {
+                auto oldest = _idleTrees.find(_usage.back());
+                if ( oldest != _idleTrees.end()) {
+                    evictedScript.swap((*oldest).second);
+                    _idleTrees.erase(oldest);
+                }
+                _usage.pop_back();
+            }
+            iter = _idleTrees.insert(std::make_pair(key, std::list<UPASTNode>())).first;
+            _usage.push_front(key);
+        }
+        if ( (*iter).second.size() < MAXTREESPERSCRIPT)
+            (*iter).second.push_back(std::move(tree));
+        else
+            evicted = std::move(tree);
+    }
+}
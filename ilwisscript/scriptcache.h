@@ -0,0 +1,50 @@
+#ifndef SCRIPTCACHE_H
+#define SCRIPTCACHE_H
+
+#include <mutex>
+#include <list>
+#include <map>
+#include <memory>
+#include <QByteArray>
+
+namespace Ilwis {
+
+class ASTNode;
+
+typedef std::unique_ptr<ASTNode> UPASTNode;
+
+/*!
+ The ScriptCache keeps the syntax trees of scripts that have been executed, keyed by a hash of the script text.
+ Executing the same script again takes a tree from the cache instead of lexing and parsing the text again.
+ A tree stores the intermediate values of its evaluation in its nodes, so a tree is only used by one execution at a time;
+ concurrent executions of the same script each take their own tree (or parse a new one) and hand it back afterwards.
+ A tree that is taken from the cache is reset to its parsed state, so it is not bound to the working catalog or symbols of an earlier run.
+ */
+class ScriptCache
+{
+public:
+    static QByteArray key(const char *text, quint32 size);
+    /*!
+     take removes an idle tree for the script from the cache
+     * \param key hash of the script text
+     * \return the tree or an empty pointer if there is no idle tree for this script
+     */
+    static UPASTNode take(const QByteArray& key);
+    /*!
+     giveBack returns a tree to the cache after it has been evaluated. Only trees of scripts that parsed without errors should be handed back
+     * \param key hash of the script text
+     * \param tree the syntax tree
+     */
+    static void giveBack(const QByteArray& key, UPASTNode tree);
+
+private:
+    static const quint32 MAXSCRIPTS = 64;
+    static const quint32 MAXTREESPERSCRIPT = 8;
+
+    static std::mutex _lock;
+    static std::map<QByteArray, std::list<UPASTNode>> _idleTrees;
+    static std::list<QByteArray> _usage; // most recently used script first
+};
+}
+
+#endif // SCRIPTCACHE_H
@@ -1,5 +1,6 @@
 #include <QString>
 #include <functional>
+#include <algorithm>
 
 #include "kernel.h"
 #include "ilwis.h"
@@ -22,6 +23,96 @@
 
 using namespace Ilwis;
 
+ProjectionImplementationProj4::ThreadHandles::ThreadHandles(const QString &targetDef, quint32 version) : _version(version)
+{
+    _context = pj_ctx_alloc();
+    if ( _context) {
+        _pjLatlon = pj_init_plus_ctx(_context, "+proj=latlong +ellps=WGS84");
+        _pjBase = pj_init_plus_ctx(_context, targetDef.toLatin1());
+    }
+}
+
+ProjectionImplementationProj4::ThreadHandles::~ThreadHandles()
+{
+    if ( _pjLatlon)
+        pj_free(_pjLatlon);
+    if ( _pjBase)
+        pj_free(_pjBase);
+    if ( _context)
+        pj_ctx_free(_context);
+}
+
+void ProjectionImplementationProj4::ThreadHandles::logError() const
+{
+    int err = _context ? pj_ctx_get_errno(_context) : *pj_get_errno_ref();
+    if ( err != 0) {
+        QString error(pj_strerrno(err));
+        error = "projection error:" + error;
+        kernel()->issues()->log(error);
+    }
+}
+
+/*!
+ * every thread keeps track of the projections it has handles in; when the thread exits it frees those of the projections that still exist
+ */
+struct ProjectionImplementationProj4::ThreadOwner {
+    ~ThreadOwner() {
+        std::thread::id thread = std::this_thread::get_id();
+        for(const std::weak_ptr<HandleMap>& weakMap : _maps) {
+            std::shared_ptr<HandleMap> map = weakMap.lock();
+            if ( map) {
+                QWriteLocker lock(&map->_lock);
+                map->_handles.erase(thread);
+            }
+        }
+    }
+    void add(const std::shared_ptr<HandleMap>& map) {
+        // projections destroyed in the mean time have already freed the handles of this thread
+        _maps.erase(std::remove_if(_maps.begin(), _maps.end(), [](const std::weak_ptr<HandleMap>& weakMap){ return weakMap.expired(); }), _maps.end());
+        _maps.push_back(map);
+    }
+
+    std::vector<std::weak_ptr<HandleMap>> _maps;
+};
+
+ProjectionImplementationProj4::ThreadHandles *ProjectionImplementationProj4::handles() const
+{
+    std::thread::id thread = std::this_thread::get_id();
+    quint32 version = _defVersion.load(std::memory_order_acquire);
+    {
+        QReadLocker lock(&_handles->_lock);
+        auto iter = _handles->_handles.find(thread);
+        if ( iter != _handles->_handles.end() && (*iter).second->_version == version)
+            return (*iter).second.get();
+    }
+    QString def;
+    {
+        std::lock_guard<std::mutex> lock(_defMutex);
+        def = _targetDef;
+        version = _defVersion.load(std::memory_order_acquire);
+    }
+    // only the calling thread uses its entry, so replacing the outdated handles of this thread is safe
+    ThreadHandles *local = new ThreadHandles(def, version);
+    bool isNew;
+    {
+        QWriteLocker lock(&_handles->_lock);
+        std::unique_ptr<ThreadHandles>& entry = _handles->_handles[thread];
+        isNew = !entry;
+        entry.reset(local);
+    }
+    if ( isNew) {
+        static thread_local ThreadOwner owner;
+        owner.add(_handles);
+    }
+
+    return local;
+}
+
+void ProjectionImplementationProj4::definitionChanged()
+{
+    _defVersion.fetch_add(1, std::memory_order_acq_rel);
+}
+
 ProjectionImplementation *ProjectionImplementationProj4::create(const Resource& resource) {
     return new ProjectionImplementationProj4(resource);
 }
@@ -30,6 +121,7 @@ void ProjectionImplementationProj4::setParameter(Projection::ProjectionParamValu
 {
     ProjectionImplementation::setParameter(type, v);
     QString value = v.toString();
+    std::lock_guard<std::mutex> lock(_defMutex);
     switch(type) {
     case Projection::pvX0:
         _targetDef += " +x_0=" + value;break;
@@ -60,34 +152,27 @@ void ProjectionImplementationProj4::setParameter(Projection::ProjectionParamValu
     default:
         _targetDef += "";
     }
-    if ( _pjBase)
-        pj_free(_pjBase);
-
-    _pjBase = pj_init_plus(_targetDef.toLatin1());
+    definitionChanged();
 }
 
-ProjectionImplementationProj4::ProjectionImplementationProj4(const Resource &resource)
+ProjectionImplementationProj4::ProjectionImplementationProj4(const Resource &resource) : _defVersion(0), _handles(new HandleMap())
 {
     QString cd = resource.code();
     _outputIsLatLon = cd == "latlong" || cd == "longlat";
     _targetDef = QString("+proj=%1").arg(cd);
-    _pjLatlon =  pj_init_plus("+proj=latlong +ellps=WGS84");
-    _pjBase = pj_init_plus(_targetDef.toLatin1());
 }
 
-ProjectionImplementationProj4::ProjectionImplementationProj4(const QString &code)
+ProjectionImplementationProj4::ProjectionImplementationProj4(const QString &code) : _defVersion(0), _handles(new HandleMap())
 {
     _outputIsLatLon = code.indexOf("latlong") != -1 || code.indexOf("longlat") != -1;
     _targetDef = code;
-    _pjLatlon =  pj_init_plus("+proj=latlong +ellps=WGS84");
-    _pjBase = pj_init_plus(_targetDef.toLatin1());
 }
 
 
 ProjectionImplementationProj4::~ProjectionImplementationProj4()
 {
-    pj_free(_pjLatlon);
-    pj_free(_pjBase);
+    QWriteLocker lock(&_handles->_lock);
+    _handles->_handles.clear();
 }
 
 bool ProjectionImplementationProj4::prepare(const QString &parms)
@@ -106,48 +191,46 @@ bool ProjectionImplementationProj4::prepare(const QString &parms)
                 setParameter(v, sv.toDouble());
             }
         };
-        QString ellps = proj4["ellps"];
-        if ( ellps != sUNDEF) {
-            _targetDef += " +ellps=" + ellps;
-        }
-        QString a = proj4["a"];
-        if ( a != sUNDEF) {
-            _targetDef += " +a=" + a;
-        }
-        QString b = proj4["b"];
-        if ( b != sUNDEF) {
-            _targetDef += " +b=" + b;
-        }
-        QString shifts = proj4["towgs84"];
-        if ( shifts != sUNDEF) {
-            _targetDef += " +towgs84=" + shifts;
-        }
+        {
+            std::lock_guard<std::mutex> lock(_defMutex);
+            QString ellps = proj4["ellps"];
+            if ( ellps != sUNDEF) {
+                _targetDef += " +ellps=" + ellps;
+            }
+            QString a = proj4["a"];
+            if ( a != sUNDEF) {
+                _targetDef += " +a=" + a;
+            }
+            QString b = proj4["b"];
+            if ( b != sUNDEF) {
+                _targetDef += " +b=" + b;
+            }
+            QString shifts = proj4["towgs84"];
+            if ( shifts != sUNDEF) {
+                _targetDef += " +towgs84=" + shifts;
+            }
 
-        QString name = proj4["datum"];
-        if ( name != sUNDEF) {
-            _targetDef += " +datum=" + name;
+            QString name = proj4["datum"];
+            if ( name != sUNDEF) {
+                _targetDef += " +datum=" + name;
+            }
         }
 
         for(auto iter= alias.begin(); iter != alias.end(); ++iter) {
             assign(iter->first);
         }
-        if ( _pjBase)
-            pj_free(_pjBase);
-
-        _pjBase = pj_init_plus(_targetDef.toLatin1());
+        definitionChanged();
         return true;
     }
     else if ( _coordinateSystem != 0) {
+        std::lock_guard<std::mutex> lock(_defMutex);
         if ( _coordinateSystem->ellipsoid().isValid()) {
             _targetDef += " " + _coordinateSystem->ellipsoid()->code();
         }
         if ( _coordinateSystem->datum() && _coordinateSystem->datum()->isValid()) {
             _targetDef += " " + _coordinateSystem->datum()->code();
         }
-        if ( _pjBase)
-            pj_free(_pjBase);
-
-        _pjBase = pj_init_plus(_targetDef.toLatin1());
+        definitionChanged();
         return true;
     }
     return ERROR1(ERR_NO_INITIALIZED_1,"Projection");
@@ -155,24 +238,21 @@ bool ProjectionImplementationProj4::prepare(const QString &parms)
 
 QString ProjectionImplementationProj4::toProj4() const
 {
+    std::lock_guard<std::mutex> lock(_defMutex);
     return _targetDef;
 }
 
 Coordinate ProjectionImplementationProj4::latlon2coord(const LatLon &ll) const
 {
-    if ( _pjBase == 0 || _pjLatlon == 0) {
-        int *err = pj_get_errno_ref();
-        if (*err != 0){
-            QString error(pj_strerrno(*err));
-            error = "projection error:" + error;
-            kernel()->issues()->log(error);
-        }
+    const ThreadHandles *local = handles();
+    if ( local->_pjBase == 0 || local->_pjLatlon == 0) {
+        local->logError();
         return Coordinate();
     }
 
     double x = ll.lon().radians();
     double y = ll.lat().radians();
-    int err = pj_transform(_pjLatlon, _pjBase, 1, 1, &x, &y, NULL );
+    int err = pj_transform(local->_pjLatlon, local->_pjBase, 1, 1, &x, &y, NULL );
     if ( err != 0) {
         QString error(pj_strerrno(err));
         error = "projection error:" + error;
@@ -189,20 +269,15 @@ Coordinate ProjectionImplementationProj4::latlon2coord(const LatLon &ll) const
 
 LatLon ProjectionImplementationProj4::coord2latlon(const Coordinate &crd) const
 {
-
-    if ( _pjBase == 0 || _pjLatlon == 0){
-        int *err = pj_get_errno_ref();
-        if (err != 0){
-            QString error(pj_strerrno(*err));
-            error = "projection error:" + error;
-            kernel()->issues()->log(error);
-        }
+    const ThreadHandles *local = handles();
+    if ( local->_pjBase == 0 || local->_pjLatlon == 0){
+        local->logError();
         return LatLon();
     }
 
     double x = crd.x;
     double y = crd.y;
-    int err = pj_transform(_pjBase,_pjLatlon, 1, 1, &x, &y, NULL );
+    int err = pj_transform(local->_pjBase, local->_pjLatlon, 1, 1, &x, &y, NULL );
     if ( err != 0) {
         QString error(pj_strerrno(err));
         error = "projection error:" + error;
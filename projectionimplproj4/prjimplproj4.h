@@ -1,6 +1,14 @@
 #ifndef PROJECTIONIMPLEMENTATIONPROJ4_H
 #define PROJECTIONIMPLEMENTATIONPROJ4_H
 
+#include <QReadWriteLock>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace Ilwis {
 class ProjectionImplementationProj4 : public ProjectionImplementation
 {
@@ -18,10 +26,40 @@ public:
      bool prepare(const QString& parms="");
      QString toProj4() const;
 private:
+    /*!
+     * proj4 objects are not reentrant. Every thread that uses the projection gets its own context and
+     * its own pair of projection objects. They are created on first use in a thread and recreated when the
+     * definition of the projection has changed since they were made. The handles of a thread are freed when
+     * the thread exits or when the projection is destroyed, whichever comes first.
+     */
+    struct ThreadHandles {
+        ThreadHandles(const QString& targetDef, quint32 version);
+        ~ThreadHandles();
+        void logError() const;
+
+        projCtx _context = 0;
+        projPJ  _pjLatlon = 0;
+        projPJ  _pjBase = 0;
+        quint32 _version;
+    };
+
+    /*!
+     * the handles of all threads; shared with the threads that made them, so that an exiting thread can remove its own
+     */
+    struct HandleMap {
+        QReadWriteLock _lock;
+        std::map<std::thread::id, std::unique_ptr<ThreadHandles>> _handles;
+    };
+    struct ThreadOwner;
+
+    ThreadHandles *handles() const;
+    void definitionChanged();
+
     QString _targetDef;
-    projPJ  _pjLatlon;
-    projPJ  _pjBase;
     bool _outputIsLatLon;
+    std::atomic<quint32> _defVersion;
+    mutable std::mutex _defMutex;
+    std::shared_ptr<HandleMap> _handles;
 };
 }
 